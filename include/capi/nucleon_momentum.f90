@@ -0,0 +1,140 @@
+!> @file nucleon_momentum.f90
+!> @brief Fortran 2003 interface to libnucleon_momentum (see nucleon_momentum.h).
+!>
+!> Strings passed to the library end with c_null_char, e.g.
+!>     model = nm_model_from_json("models_config.json" // c_null_char, &
+!>                                "paris" // c_null_char, 400, 0.4d0)
+!> Arrays are passed as real(c_double) arrays with their size as integer(c_size_t).
+module nucleon_momentum
+    use, intrinsic :: iso_c_binding
+    implicit none
+
+    !> NM_API_VERSION of the C header (renamed: Fortran names ignore case).
+    integer(c_int), parameter :: NM_MODULE_API_VERSION = 1
+    integer(c_int), parameter :: NM_OK = 0
+    integer(c_int), parameter :: NM_ERROR_ARGUMENT = 1
+
+    !> Random state owned by the caller; see nm_rng in nucleon_momentum.h.
+    type, bind(c) :: nm_rng
+        integer(c_int64_t) :: state(4)
+    end type nm_rng
+
+    interface
+        function nm_api_version() bind(c, name="nm_api_version")
+            import :: c_int
+            integer(c_int) :: nm_api_version
+        end function nm_api_version
+
+        function nm_model_from_json(config_path, model_name, steps, max_momentum) &
+                bind(c, name="nm_model_from_json")
+            import :: c_ptr, c_char, c_int, c_double
+            character(kind=c_char), dimension(*), intent(in) :: config_path, model_name
+            integer(c_int), value :: steps
+            real(c_double), value :: max_momentum
+            type(c_ptr) :: nm_model_from_json
+        end function nm_model_from_json
+
+        function nm_model_from_table(path, momentum_in_fm, normalize) bind(c, name="nm_model_from_table")
+            import :: c_ptr, c_char, c_int
+            character(kind=c_char), dimension(*), intent(in) :: path
+            integer(c_int), value :: momentum_in_fm, normalize
+            type(c_ptr) :: nm_model_from_table
+        end function nm_model_from_table
+
+        function nm_model_from_arrays(momenta, densities, count) bind(c, name="nm_model_from_arrays")
+            import :: c_ptr, c_double, c_size_t
+            real(c_double), dimension(*), intent(in) :: momenta, densities
+            integer(c_size_t), value :: count
+            type(c_ptr) :: nm_model_from_arrays
+        end function nm_model_from_arrays
+
+        subroutine nm_model_destroy(model) bind(c, name="nm_model_destroy")
+            import :: c_ptr
+            type(c_ptr), value :: model
+        end subroutine nm_model_destroy
+
+        function nm_model_size(model) bind(c, name="nm_model_size")
+            import :: c_ptr, c_size_t
+            type(c_ptr), value :: model
+            integer(c_size_t) :: nm_model_size
+        end function nm_model_size
+
+        function nm_model_momenta(model) bind(c, name="nm_model_momenta")
+            import :: c_ptr
+            type(c_ptr), value :: model
+            type(c_ptr) :: nm_model_momenta
+        end function nm_model_momenta
+
+        function nm_model_densities(model) bind(c, name="nm_model_densities")
+            import :: c_ptr
+            type(c_ptr), value :: model
+            type(c_ptr) :: nm_model_densities
+        end function nm_model_densities
+
+        function nm_model_min_momentum(model) bind(c, name="nm_model_min_momentum")
+            import :: c_ptr, c_double
+            type(c_ptr), value :: model
+            real(c_double) :: nm_model_min_momentum
+        end function nm_model_min_momentum
+
+        function nm_model_max_momentum(model) bind(c, name="nm_model_max_momentum")
+            import :: c_ptr, c_double
+            type(c_ptr), value :: model
+            real(c_double) :: nm_model_max_momentum
+        end function nm_model_max_momentum
+
+        function nm_model_norm(model) bind(c, name="nm_model_norm")
+            import :: c_ptr, c_double
+            type(c_ptr), value :: model
+            real(c_double) :: nm_model_norm
+        end function nm_model_norm
+
+        function nm_evaluate(model, momenta, densities, count) bind(c, name="nm_evaluate")
+            import :: c_ptr, c_double, c_size_t, c_int
+            type(c_ptr), value :: model
+            real(c_double), dimension(*), intent(in) :: momenta
+            real(c_double), dimension(*), intent(out) :: densities
+            integer(c_size_t), value :: count
+            integer(c_int) :: nm_evaluate
+        end function nm_evaluate
+
+        function nm_cdf(model, momenta, probabilities, count) bind(c, name="nm_cdf")
+            import :: c_ptr, c_double, c_size_t, c_int
+            type(c_ptr), value :: model
+            real(c_double), dimension(*), intent(in) :: momenta
+            real(c_double), dimension(*), intent(out) :: probabilities
+            integer(c_size_t), value :: count
+            integer(c_int) :: nm_cdf
+        end function nm_cdf
+
+        function nm_quantile(model, probabilities, momenta, count) bind(c, name="nm_quantile")
+            import :: c_ptr, c_double, c_size_t, c_int
+            type(c_ptr), value :: model
+            real(c_double), dimension(*), intent(in) :: probabilities
+            real(c_double), dimension(*), intent(out) :: momenta
+            integer(c_size_t), value :: count
+            integer(c_int) :: nm_quantile
+        end function nm_quantile
+
+        subroutine nm_rng_seed(rng, seed) bind(c, name="nm_rng_seed")
+            import :: nm_rng, c_int64_t
+            type(nm_rng), intent(out) :: rng
+            integer(c_int64_t), value :: seed
+        end subroutine nm_rng_seed
+
+        function nm_rng_uniform(rng) bind(c, name="nm_rng_uniform")
+            import :: nm_rng, c_double
+            type(nm_rng), intent(inout) :: rng
+            real(c_double) :: nm_rng_uniform
+        end function nm_rng_uniform
+
+        function nm_sample(model, rng, momenta, count) bind(c, name="nm_sample")
+            import :: c_ptr, nm_rng, c_double, c_size_t, c_int
+            type(c_ptr), value :: model
+            type(nm_rng), intent(inout) :: rng
+            real(c_double), dimension(*), intent(out) :: momenta
+            integer(c_size_t), value :: count
+            integer(c_int) :: nm_sample
+        end function nm_sample
+    end interface
+end module nucleon_momentum
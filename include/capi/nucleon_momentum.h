@@ -0,0 +1,185 @@
+#ifndef CAPI_NUCLEON_MOMENTUM_H
+#define CAPI_NUCLEON_MOMENTUM_H
+
+/**
+ * @file nucleon_momentum.h
+ * @brief C interface of the nucleon momentum distributions for C and Fortran programs.
+ *
+ * The library libnucleon_momentum exports only the functions declared here,
+ * under the symbol version NUCLEON_MOMENTUM_1. Functions are only ever added to
+ * this interface, and existing ones keep their signatures and behaviour, so a
+ * program linked against version 1 runs with every later build of the library.
+ *
+ * A model is an opaque handle holding one tabulated distribution. It is
+ * created from the deuteron model configuration, from a table file or from
+ * two arrays, and is immutable afterwards: any number of threads may evaluate
+ * and sample one model at the same time, each with its own random state.
+ *
+ * Batch calls process whole arrays, so one call per event block replaces the
+ * per-event calls or intermediate files of a generator. Momenta are in GeV/c.
+ * Error messages of the loaders are written to the standard error stream.
+ *
+ * Fortran programs use the module in nucleon_momentum.f90 next to this header.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Version of this interface; see nm_api_version(). */
+#define NM_API_VERSION 1
+
+/** Status codes of the batch functions. */
+#define NM_OK 0                 /**< Success. */
+#define NM_ERROR_ARGUMENT 1     /**< A null model, state or array was passed. */
+
+/** Opaque handle of a tabulated distribution. */
+typedef struct nm_model nm_model;
+
+/**
+ * @brief Random state of the sampling functions, owned by the caller.
+ *
+ * The generator is xoshiro256** and the state is plain data: it may be copied
+ * to fork a stream, stored to resume a run or kept per thread. A given seed
+ * yields the same momenta on every platform and with every library version.
+ */
+typedef struct nm_rng {
+    uint64_t state[4];
+} nm_rng;
+
+/**
+ * @brief Version of the interface implemented by the loaded library.
+ *
+ * @return NM_API_VERSION of the library build; at least that of the header
+ *         the program was compiled with.
+ */
+int nm_api_version(void);
+
+/**
+ * @brief Calculates the deuteron distribution of a model in a JSON configuration.
+ *
+ * @param config_path Path of the model configuration (like src/deuteron/models_config.json).
+ * @param model_name Name of the model, e.g. "paris".
+ * @param steps Number of momentum steps (the executable uses 400).
+ * @param max_momentum Upper end of the momentum grid in GeV/c (the executable uses 0.4).
+ * @return New model, or NULL if the configuration or the model is not usable.
+ */
+nm_model* nm_model_from_json(
+    const char* config_path, const char* model_name, int steps, double max_momentum);
+
+/**
+ * @brief Loads a distribution table file.
+ *
+ * Binary distribution files (written with --format binary) are recognised by
+ * their magic and read as they are; other files are read as two-column text
+ * tables and converted like the 3He tables.
+ *
+ * @param path Path of the table.
+ * @param momentum_in_fm Non-zero if the text table gives momenta in fm^-1.
+ * @param normalize Non-zero to normalise the text table to unit integral.
+ * @return New model, or NULL if the file cannot be read.
+ */
+nm_model* nm_model_from_table(const char* path, int momentum_in_fm, int normalize);
+
+/**
+ * @brief Builds a model from two arrays, which are copied.
+ *
+ * @param momenta Strictly increasing momenta.
+ * @param densities Probability densities at the momenta.
+ * @param count Number of points in both arrays (at least two).
+ * @return New model, or NULL if the table cannot be sampled.
+ */
+nm_model* nm_model_from_arrays(const double* momenta, const double* densities, size_t count);
+
+/**
+ * @brief Frees a model; NULL is ignored.
+ */
+void nm_model_destroy(nm_model* model);
+
+/**
+ * @brief Number of tabulated points of a model, or zero for NULL.
+ */
+size_t nm_model_size(const nm_model* model);
+
+/**
+ * @brief Tabulated momenta, valid until the model is destroyed; NULL for NULL.
+ */
+const double* nm_model_momenta(const nm_model* model);
+
+/**
+ * @brief Tabulated densities as loaded, valid until the model is destroyed; NULL for NULL.
+ */
+const double* nm_model_densities(const nm_model* model);
+
+/**
+ * @brief Lower end of the tabulated momentum range.
+ */
+double nm_model_min_momentum(const nm_model* model);
+
+/**
+ * @brief Upper end of the tabulated momentum range.
+ */
+double nm_model_max_momentum(const nm_model* model);
+
+/**
+ * @brief Integral of the tabulated densities, by which the results are normalised.
+ */
+double nm_model_norm(const nm_model* model);
+
+/**
+ * @brief Normalised densities (linear between the tabulated points, zero outside).
+ *
+ * @param model Model to evaluate.
+ * @param momenta Momenta to evaluate at.
+ * @param densities Output array; may be the input array.
+ * @param count Number of points.
+ * @return NM_OK, or NM_ERROR_ARGUMENT.
+ */
+int nm_evaluate(const nm_model* model, const double* momenta, double* densities, size_t count);
+
+/**
+ * @brief Cumulative distribution function at a batch of momenta.
+ *
+ * @return NM_OK, or NM_ERROR_ARGUMENT.
+ */
+int nm_cdf(const nm_model* model, const double* momenta, double* probabilities, size_t count);
+
+/**
+ * @brief Inverse of the cumulative distribution function for a batch of probabilities.
+ *
+ * Generators with their own random numbers pass their uniforms here; values
+ * outside [0, 1] are clamped.
+ *
+ * @return NM_OK, or NM_ERROR_ARGUMENT.
+ */
+int nm_quantile(const nm_model* model, const double* probabilities, double* momenta, size_t count);
+
+/**
+ * @brief Seeds a random state.
+ */
+void nm_rng_seed(nm_rng* rng, uint64_t seed);
+
+/**
+ * @brief Draws a uniform number in [0, 1) and advances the state.
+ */
+double nm_rng_uniform(nm_rng* rng);
+
+/**
+ * @brief Draws a batch of momenta and advances the state by count numbers.
+ *
+ * @param model Model to sample.
+ * @param rng Caller's random state.
+ * @param momenta Output array receiving the momenta.
+ * @param count Number of momenta to draw.
+ * @return NM_OK, or NM_ERROR_ARGUMENT.
+ */
+int nm_sample(const nm_model* model, nm_rng* rng, double* momenta, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAPI_NUCLEON_MOMENTUM_H */
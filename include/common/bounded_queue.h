@@ -0,0 +1,92 @@
+#ifndef COMMON_BOUNDED_QUEUE_H
+#define COMMON_BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/**
+ * @class BoundedQueue
+ * @brief Blocking first-in first-out queue of limited capacity between pipeline stages.
+ *
+ * Producers block in Push while the queue is full, so a fast stage cannot run
+ * arbitrarily far ahead of a slow one; consumers block in Pop while it is
+ * empty. Close marks the end of the stream: pending items are still delivered,
+ * after which Pop returns false. Any number of producers and consumers may
+ * share a queue.
+ *
+ * @tparam T Type of the queued items.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    /**
+     * @brief Constructor for a queue holding at most the given number of items.
+     *
+     * @param capacity Maximum number of queued items (at least one).
+     */
+    explicit BoundedQueue(std::size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Appends an item, waiting while the queue is full.
+     *
+     * @param item Item to append.
+     * @return True if the item was queued, false if the queue is closed.
+     */
+    bool Push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this]() { return closed || items.size() < capacity; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        not_empty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest item, waiting while the queue is empty and open.
+     *
+     * @param item Receives the removed item.
+     * @return True if an item was removed, false once the queue is closed and drained.
+     */
+    bool Pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this]() { return closed || !items.empty(); });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        not_full.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Ends the stream and wakes all waiting producers and consumers.
+     */
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+
+private:
+    const std::size_t capacity;         // Maximum number of queued items
+    std::deque<T> items;                // Queued items, oldest first
+    bool closed = false;                // No more items will be pushed
+    std::mutex mutex;                   // Guards the items and the closed flag
+    std::condition_variable not_full;   // Signalled when an item is removed
+    std::condition_variable not_empty;  // Signalled when an item is added
+};
+
+#endif // COMMON_BOUNDED_QUEUE_H
@@ -0,0 +1,85 @@
+#ifndef COMMON_CACHED_PLOT_BACKEND_H
+#define COMMON_CACHED_PLOT_BACKEND_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "plot_backend.h"
+
+/**
+ * @class CachedPlotBackend
+ * @brief Plot backend wrapper that skips plots whose image is already up to date.
+ *
+ * Before a plot is rendered, its PlotSpec (titles, ranges, styles and every
+ * data point) is hashed together with the name of the wrapped backend. The
+ * hash of the last successful rendering is kept in a sidecar file next to the
+ * image ("<image>.hash"). If the image exists and the recorded hash matches,
+ * rendering is skipped, so re-running a catalog in which one model changed
+ * redraws a single plot.
+ */
+class CachedPlotBackend : public PlotBackend {
+public:
+    /**
+     * @brief Constructor wrapping a backend.
+     *
+     * @param backend Backend that draws the plots which are out of date.
+     */
+    explicit CachedPlotBackend(std::unique_ptr<PlotBackend> backend);
+
+    /**
+     * @brief Renders the plot unless the existing image was drawn from the same input.
+     *
+     * @param spec Description of the plot.
+     * @param output_path Path of the image file.
+     * @return True if the image is up to date or was written.
+     */
+    bool Render(const PlotSpec& spec, const std::string& output_path) override;
+
+    /**
+     * @brief Opens a multi-page document with the wrapped backend.
+     *
+     * Documents are always written: their pages are streamed, so there is no
+     * point at which the whole document could be compared before writing it.
+     */
+    bool OpenDocument(const std::string& output_path) override
+    {
+        return backend->OpenDocument(output_path);
+    }
+
+    /**
+     * @brief Appends a page to the open document.
+     */
+    bool AddPage(const PlotSpec& spec) override { return backend->AddPage(spec); }
+
+    /**
+     * @brief Closes the open document.
+     */
+    bool CloseDocument() override { return backend->CloseDocument(); }
+
+    /**
+     * @brief Returns the name of the wrapped backend.
+     */
+    const char* Name() const override { return backend->Name(); }
+
+    /**
+     * @brief Renders every plot regardless of the recorded hashes.
+     *
+     * @param force If true, the sidecar files are ignored (but still updated).
+     */
+    void SetForceRender(bool force) { force_render = force; }
+
+    /**
+     * @brief Computes the 64-bit hash of a plot description.
+     *
+     * @param spec Description of the plot.
+     * @param backend_name Name of the backend, so that switching backends redraws.
+     * @return Hash of all fields of the description.
+     */
+    static std::uint64_t Fingerprint(const PlotSpec& spec, const std::string& backend_name);
+
+private:
+    std::unique_ptr<PlotBackend> backend;   // Draws the plots that are out of date
+    bool force_render = false;              // Ignore the recorded hashes
+};
+
+#endif // COMMON_CACHED_PLOT_BACKEND_H
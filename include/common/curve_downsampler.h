@@ -0,0 +1,88 @@
+#ifndef COMMON_CURVE_DOWNSAMPLER_H
+#define COMMON_CURVE_DOWNSAMPLER_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class CurveDownsampler
+ * @brief Reduces densely sampled curves to a fixed number of points before
+ *        plotting, using the Largest-Triangle-Three-Buckets (LTTB) algorithm.
+ *
+ * The interior of the curve is split into buckets of equal point count and from
+ * each bucket the point spanning the largest triangle with the previously kept
+ * point and the average of the next bucket is kept. This preserves the visual
+ * shape of the curve at screen resolution. Only original points are kept, the
+ * first and last points always are, and so are the points of the global maximum
+ * and minimum, so peaks and endpoints are drawn exactly.
+ */
+class CurveDownsampler {
+public:
+    /**
+     * @brief Constructor for a new CurveDownsampler object.
+     *
+     * @param target_points Number of points to keep; zero (or fewer than three)
+     *        disables downsampling.
+     */
+    explicit CurveDownsampler(std::size_t target_points = 0)
+        : target_points(target_points) {}
+
+    /**
+     * @brief Sets the number of points to keep; zero disables downsampling.
+     */
+    void SetTargetPoints(std::size_t points) { target_points = points; }
+
+    /**
+     * @brief Returns the number of points to keep (zero if disabled).
+     */
+    std::size_t TargetPoints() const { return target_points; }
+
+    /**
+     * @brief Returns true if a curve of the given size would be reduced.
+     */
+    bool IsActive(std::size_t size) const {
+        return target_points >= 3 && size > target_points;
+    }
+
+    /**
+     * @brief Selects the points of a curve to keep.
+     *
+     * @param x Abscissae in ascending order.
+     * @param y Ordinates.
+     * @param size Number of points.
+     * @return Ascending indices of the kept points (all points if inactive).
+     */
+    std::vector<std::size_t> SelectPoints(
+        const double* x, const double* y, std::size_t size) const;
+
+    /**
+     * @brief Selects the points of a single-precision curve to keep.
+     */
+    std::vector<std::size_t> SelectPoints(
+        const float* x, const float* y, std::size_t size) const;
+
+    /**
+     * @brief Downsamples a curve into new coordinate vectors.
+     *
+     * @param x Abscissae in ascending order.
+     * @param y Ordinates.
+     * @param size Number of points.
+     * @param out_x Vector receiving the kept abscissae.
+     * @param out_y Vector receiving the kept ordinates.
+     */
+    void Downsample(
+        const double* x, const double* y, std::size_t size,
+        std::vector<double>& out_x, std::vector<double>& out_y) const;
+
+    /**
+     * @brief Downsamples a single-precision curve into new coordinate vectors.
+     */
+    void Downsample(
+        const float* x, const float* y, std::size_t size,
+        std::vector<float>& out_x, std::vector<float>& out_y) const;
+
+private:
+    std::size_t target_points;  // Points to keep, zero if disabled
+};
+
+#endif // COMMON_CURVE_DOWNSAMPLER_H
@@ -0,0 +1,60 @@
+#ifndef COMMON_DISTRIBUTION_FILE_H
+#define COMMON_DISTRIBUTION_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class DistributionFile
+ * @brief Reads and writes momentum distributions in a compact binary format.
+ *
+ * A binary distribution file holds the 8-byte magic "NMDBIN01", the number of
+ * points as a 64-bit unsigned integer and then the complete momentum column
+ * followed by the complete density column, both as 64-bit doubles in the byte
+ * order of the machine. Columns are stored contiguously, so a reader can map
+ * them directly instead of parsing text, and no precision is lost.
+ */
+class DistributionFile {
+public:
+    /// Magic bytes at the start of every binary distribution file.
+    static constexpr char MAGIC[8] = {'N', 'M', 'D', 'B', 'I', 'N', '0', '1'};
+
+    /// Size of the header in bytes (magic and point count).
+    static constexpr std::size_t HEADER_SIZE = 16;
+
+    /**
+     * @brief Writes a distribution held as double columns.
+     *
+     * @param file_path Path of the output file.
+     * @param momenta Momentum column in GeV/c.
+     * @param densities Probability density column.
+     * @param count Number of points in both columns.
+     * @return True if the file was written.
+     */
+    static bool WriteBinary(
+        const std::string& file_path, const double* momenta,
+        const double* densities, std::size_t count);
+
+    /**
+     * @brief Writes a distribution held as float columns (stored as doubles).
+     */
+    static bool WriteBinary(
+        const std::string& file_path, const float* momenta,
+        const float* densities, std::size_t count);
+
+    /**
+     * @brief Reads a binary distribution file.
+     *
+     * @param file_path Path of the input file.
+     * @param momenta Vector receiving the momentum column.
+     * @param densities Vector receiving the probability density column.
+     * @return True if the file is a complete binary distribution file.
+     */
+    static bool ReadBinary(
+        const std::string& file_path, std::vector<double>& momenta,
+        std::vector<double>& densities);
+};
+
+#endif // COMMON_DISTRIBUTION_FILE_H
@@ -0,0 +1,86 @@
+#ifndef COMMON_DISTRIBUTION_STATISTICS_H
+#define COMMON_DISTRIBUTION_STATISTICS_H
+
+#include <cstddef>
+
+/**
+ * @struct DistributionStatistics
+ * @brief Validation counters and summary statistics of a tabulated momentum distribution.
+ */
+struct DistributionStatistics {
+    std::size_t rows = 0;               ///< Number of valid rows.
+    std::size_t bad_rows = 0;           ///< Number of lines that could not be parsed.
+    std::size_t non_monotonic = 0;      ///< Rows whose momentum does not exceed the previous one.
+    std::size_t negative = 0;           ///< Rows with a negative probability density.
+    double min_momentum = 0.;           ///< Smallest momentum.
+    double max_momentum = 0.;           ///< Largest momentum.
+    double min_density = 0.;            ///< Smallest probability density.
+    double max_density = 0.;            ///< Largest probability density.
+    double trapezoid_integral = 0.;     ///< Integral over momentum (trapezoidal rule).
+    double simpson_integral = 0.;       ///< Integral over momentum (composite Simpson rule).
+    double mean_momentum = 0.;          ///< Density-weighted mean momentum.
+
+    /**
+     * @brief Checks that the table parsed cleanly, is strictly ordered and non-negative.
+     */
+    bool IsValid() const {
+        return rows >= 2 && bad_rows == 0 && non_monotonic == 0 && negative == 0;
+    }
+};
+
+/**
+ * @class StatisticsAccumulator
+ * @brief Computes DistributionStatistics incrementally over blocks of rows.
+ *
+ * Blocks are passed in table order; the points needed to join integration
+ * intervals across block boundaries are carried internally, so the result does
+ * not depend on how the table was split. Each block is processed in a single
+ * pass with independent per-lane accumulators, which lets the compiler
+ * vectorize the reductions.
+ */
+class StatisticsAccumulator {
+public:
+    /**
+     * @brief Default constructor creating an empty accumulator.
+     */
+    StatisticsAccumulator() = default;
+
+    /**
+     * @brief Adds a block of consecutive rows.
+     *
+     * @param momenta Pointer to the momentum column of the block.
+     * @param densities Pointer to the probability density column of the block.
+     * @param count Number of rows in the block.
+     */
+    void Add(const float* momenta, const float* densities, std::size_t count);
+
+    /**
+     * @brief Records a line that could not be parsed.
+     */
+    void AddBadRow() { ++bad_rows; }
+
+    /**
+     * @brief Returns the statistics of all rows added so far.
+     */
+    DistributionStatistics Result() const;
+
+private:
+    std::size_t rows = 0;
+    std::size_t bad_rows = 0;
+    std::size_t non_monotonic = 0;
+    std::size_t negative = 0;
+    double min_momentum = 0., max_momentum = 0.;
+    double min_density = 0., max_density = 0.;
+    double trapezoid = 0.;          // Integral of the density
+    double first_moment = 0.;       // Integral of momentum times density
+    double simpson = 0.;            // Simpson integral over completed interval pairs
+    double last_momentum = 0.;      // Last row of the previous block
+    double last_density = 0.;
+    double pair_start_momentum = 0.; // First point of the pending Simpson pair
+    double pair_start_density = 0.;
+    double pair_mid_momentum = 0.;  // Middle point of the pending Simpson pair
+    double pair_mid_density = 0.;
+    bool has_pair_mid = false;      // True if the pending pair has its middle point
+};
+
+#endif // COMMON_DISTRIBUTION_STATISTICS_H
@@ -0,0 +1,94 @@
+#ifndef COMMON_FAST_FOURIER_TRANSFORM_H
+#define COMMON_FAST_FOURIER_TRANSFORM_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class FastFourierTransform
+ * @brief In-place radix-2 complex FFT with precomputed twiddle factors.
+ *
+ * The bit-reversal permutation and twiddle factors are computed once in the
+ * constructor, so repeated transforms of the same length only pay for the
+ * butterflies.
+ */
+class FastFourierTransform {
+public:
+    /**
+     * @brief Prepares transforms of a given length.
+     *
+     * @param size Transform length; rounded up to the next power of two.
+     */
+    explicit FastFourierTransform(std::size_t size);
+
+    /**
+     * @brief Returns the transform length.
+     */
+    std::size_t Size() const { return size; }
+
+    /**
+     * @brief Computes X_m = sum_j x_j exp(-2 pi i j m / N) in place.
+     *
+     * @param data Array of Size() complex values.
+     */
+    void Forward(std::complex<double>* data) const;
+
+    /**
+     * @brief Computes x_j = sum_m X_m exp(+2 pi i j m / N) in place (without the 1/N factor).
+     *
+     * @param data Array of Size() complex values.
+     */
+    void Inverse(std::complex<double>* data) const;
+
+private:
+    std::size_t size;                           // Transform length (power of two)
+    std::vector<std::size_t> bit_reversed;      // Bit-reversal permutation
+    std::vector<std::complex<double>> twiddles; // exp(-2 pi i k / N), k < N/2
+
+    /**
+     * @brief Runs the butterflies in the given direction.
+     *
+     * @param data Array of Size() complex values.
+     * @param inverse True for the positive exponent.
+     */
+    void Transform(std::complex<double>* data, bool inverse) const;
+};
+
+/**
+ * @class SineTransform
+ * @brief Type-I discrete sine transform evaluated through a complex FFT.
+ *
+ * Computes S_m = sum_{j=1}^{N-1} f_j sin(pi j m / N) for m = 0 .. N-1 with an
+ * FFT of length 2N on the odd extension of f, i.e. in O(N log N).
+ */
+class SineTransform {
+public:
+    /**
+     * @brief Prepares transforms of a given length.
+     *
+     * @param points Number of samples N, including the vanishing f_0; rounded up 
+     *        to the next power of two.
+     */
+    explicit SineTransform(std::size_t points);
+
+    /**
+     * @brief Returns the number of samples N.
+     */
+    std::size_t Size() const { return points; }
+
+    /**
+     * @brief Transforms N samples; input and output may alias.
+     *
+     * @param input Array of N samples (input[0] is ignored).
+     * @param output Array receiving the N transform values (output[0] is zero).
+     */
+    void Transform(const double* input, double* output) const;
+
+private:
+    std::size_t points;                             // Number of samples N
+    FastFourierTransform fft;                       // FFT of length 2N
+    mutable std::vector<std::complex<double>> work; // Odd extension buffer
+};
+
+#endif // COMMON_FAST_FOURIER_TRANSFORM_H
@@ -0,0 +1,74 @@
+#ifndef COMMON_FILE_WATCHER_H
+#define COMMON_FILE_WATCHER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @class FileWatcher
+ * @brief Waits for changes of a set of files with Linux inotify.
+ *
+ * The directory of every watched file is watched rather than the file itself,
+ * so files replaced by an editor (written to a temporary file and renamed) are
+ * still reported. A file counts as changed when a writer closes it or when
+ * another file is renamed onto its name; events for other files in the same
+ * directories are ignored.
+ *
+ * Another thread may call Interrupt() to end a wait, e.g. before the thread
+ * watching the files is joined.
+ */
+class FileWatcher {
+public:
+    /**
+     * @brief Constructor creating the inotify instance.
+     */
+    FileWatcher();
+
+    /**
+     * @brief Destructor closing the inotify instance.
+     */
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief Checks whether the inotify instance could be created.
+     */
+    bool IsValid() const { return descriptor >= 0; }
+
+    /**
+     * @brief Adds a file to the watched set.
+     *
+     * @param file_path Path of the file; it need not exist yet, but its directory must.
+     * @return True if the directory of the file is watched.
+     */
+    bool Add(const std::string& file_path);
+
+    /**
+     * @brief Blocks until watched files change.
+     *
+     * After the first change, further events are collected until none arrived
+     * for the settle time, so the burst of events of one save is reported once.
+     *
+     * @param settle_ms Quiet time in milliseconds that ends a burst of events.
+     * @return Paths of the changed files as given to Add, or an empty list on
+     *         error or after Interrupt.
+     */
+    std::vector<std::string> WaitForChanges(int settle_ms = 50);
+
+    /**
+     * @brief Ends the current and all further waits; safe to call from any thread.
+     *
+     * WaitForChanges returns an empty list from then on.
+     */
+    void Interrupt();
+
+private:
+    int descriptor = -1;    // inotify instance
+    int wake_descriptor = -1;   // eventfd signalled by Interrupt
+    std::map<int, std::map<std::string, std::string>> watches; // Watch descriptor -> file name -> path
+};
+
+#endif // COMMON_FILE_WATCHER_H
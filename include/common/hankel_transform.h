@@ -0,0 +1,117 @@
+#ifndef COMMON_HANKEL_TRANSFORM_H
+#define COMMON_HANKEL_TRANSFORM_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+#include "fast_fourier_transform.h"
+
+/**
+ * @class HankelTransform
+ * @brief Fast spherical Hankel (Fourier-Bessel) transform between coordinate
+ *        and momentum space using the logarithmic FFT method (FFTLog).
+ *
+ * For a partial wave of orbital momentum l the transform pair
+ *
+ *   f(k) = sqrt(2/pi) * integral f(r) j_l(kr) r^2 dr
+ *   f(r) = sqrt(2/pi) * integral f(k) j_l(kr) k^2 dk
+ *
+ * is evaluated on logarithmically spaced grids in r and k, where it becomes a
+ * convolution computed with two FFTs, i.e. in O(N log N). Coordinate-space
+ * wave functions psi(r) = u(r)/r transform into momentum-space wave functions
+ * psi(k), whose square times k^2 is the momentum distribution. The units of k
+ * are the inverse units of r (fm^-1 for r in fm; multiply by 0.19733 for GeV/c).
+ *
+ * Functions given on other grids (e.g. MomentumDataLoader tables) can be put
+ * onto RadialGrid() or MomentumGrid() with MomentumResampler.
+ */
+class HankelTransform {
+public:
+    /**
+     * @brief Prepares transforms for one orbital momentum on a logarithmic grid.
+     *
+     * @param order Orbital momentum l of the spherical Bessel function j_l.
+     * @param r_min Smallest radius of the coordinate-space grid.
+     * @param r_max Largest radius of the coordinate-space grid.
+     * @param points Number of grid points; rounded up to the next power of two.
+     */
+    HankelTransform(int order, double r_min, double r_max, std::size_t points);
+
+    /**
+     * @brief Returns the orbital momentum l of the transform.
+     */
+    int Order() const { return order; }
+
+    /**
+     * @brief Returns the logarithmic coordinate-space grid.
+     */
+    const std::vector<double>& RadialGrid() const { return radii; }
+
+    /**
+     * @brief Returns the logarithmic momentum-space grid.
+     */
+    const std::vector<double>& MomentumGrid() const { return momenta; }
+
+    /**
+     * @brief Transforms a function sampled on RadialGrid() to MomentumGrid().
+     *
+     * @param values Function values f(r) on RadialGrid().
+     * @return Transformed values f(k) on MomentumGrid().
+     */
+    std::vector<double> ToMomentumSpace(const std::vector<double>& values) const;
+
+    /**
+     * @brief Transforms a function sampled on MomentumGrid() back to RadialGrid().
+     *
+     * @param values Function values f(k) on MomentumGrid().
+     * @return Transformed values f(r) on RadialGrid().
+     */
+    std::vector<double> ToCoordinateSpace(const std::vector<double>& values) const;
+
+    /**
+     * @brief Computes the momentum distribution k^2 |psi(k)|^2 of a reduced
+     *        radial wave function u(r) = r psi(r).
+     *
+     * @param reduced_wave_function u(r) on RadialGrid().
+     * @return Momentum distribution on MomentumGrid().
+     */
+    std::vector<double> WaveFunctionToDistribution(
+        const std::vector<double>& reduced_wave_function) const;
+
+    /**
+     * @brief Computes the coordinate-space density r^2 |psi(r)|^2 for a momentum
+     *        distribution k^2 |psi(k)|^2 of a single partial wave.
+     *
+     * The momentum-space wave function is taken as the non-negative root
+     * psi(k) = sqrt(rho(k)) / k, which holds for a nodeless ground state.
+     *
+     * @param distribution Momentum distribution rho(k) on MomentumGrid().
+     * @return Coordinate-space density on RadialGrid().
+     */
+    std::vector<double> DistributionToCoordinateSpace(
+        const std::vector<double>& distribution) const;
+
+private:
+    int order;                                      // Orbital momentum l
+    double mu;                                      // Bessel order l + 1/2
+    std::vector<double> radii;                      // Logarithmic r grid
+    std::vector<double> momenta;                    // Logarithmic k grid
+    FastFourierTransform fft;                       // FFT of the grid length
+    std::vector<std::complex<double>> kernel;       // FFTLog coefficients u_m
+    mutable std::vector<std::complex<double>> work; // Transform buffer
+
+    /**
+     * @brief Runs the FFTLog convolution from one logarithmic grid to the other.
+     *
+     * @param input Values f on the source grid.
+     * @param source Source grid (radii or momenta).
+     * @param target Target grid (momenta or radii).
+     * @return Transformed values on the target grid.
+     */
+    std::vector<double> Transform(
+        const std::vector<double>& input,
+        const std::vector<double>& source,
+        const std::vector<double>& target) const;
+};
+
+#endif // COMMON_HANKEL_TRANSFORM_H
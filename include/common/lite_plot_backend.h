@@ -0,0 +1,63 @@
+#ifndef COMMON_LITE_PLOT_BACKEND_H
+#define COMMON_LITE_PLOT_BACKEND_H
+
+#include <string>
+#include "pdf_writer.h"
+#include "plot_backend.h"
+
+/**
+ * @class LitePlotBackend
+ * @brief Built-in plot renderer writing SVG and PNG files without ROOT.
+ *
+ * The backend covers what the plot generators need: line and marker curves
+ * with ROOT colours and line styles, a framed axis system with ticks and
+ * labels, axis titles, a plot title and a legend. The layout follows the
+ * defaults of a ROOT canvas (10% margins, legend in the upper right corner).
+ *
+ * The output format is taken from the file extension: ".svg" produces a
+ * vector image, ".png" a raster image drawn with a 5x7 bitmap font and encoded
+ * by PngWriter, ".pdf" a vector page written by PdfWriter. Multi-page PDF
+ * documents are streamed page by page. No library is loaded, so a plot costs well below a millisecond
+ * of drawing plus the time to write the file.
+ */
+class LitePlotBackend : public PlotBackend {
+public:
+    /**
+     * @brief Renders a plot to an SVG, PNG or PDF file, depending on the extension.
+     *
+     * @param spec Description of the plot.
+     * @param output_path Path of the image file (".svg", ".png" or ".pdf").
+     * @return True if the file was written, false for other extensions or I/O errors.
+     */
+    bool Render(const PlotSpec& spec, const std::string& output_path) override;
+
+    /**
+     * @brief Opens a multi-page PDF document.
+     */
+    bool OpenDocument(const std::string& output_path) override;
+
+    /**
+     * @brief Appends a plot as a new page of the open document.
+     */
+    bool AddPage(const PlotSpec& spec) override;
+
+    /**
+     * @brief Completes and closes the open document.
+     */
+    bool CloseDocument() override;
+
+    /**
+     * @brief Returns "lite".
+     */
+    const char* Name() const override { return "lite"; }
+
+private:
+    PdfWriter document;     // Open multi-page document
+
+    /**
+     * @brief Draws a plot as a page of a PDF document.
+     */
+    static bool WritePage(const PlotSpec& spec, PdfWriter& writer);
+};
+
+#endif // COMMON_LITE_PLOT_BACKEND_H
@@ -0,0 +1,203 @@
+#ifndef COMMON_MOMENTUM_INTERPOLATOR_H
+#define COMMON_MOMENTUM_INTERPOLATOR_H
+
+#include <cstddef>
+#include <vector>
+#include <utility>  // For std::pair
+
+/**
+ * @enum InterpolationMethod
+ * @brief Interpolation schemes supported by MomentumInterpolator.
+ */
+enum class InterpolationMethod {
+    kLinear,        ///< Piecewise linear interpolation.
+    kCubicSpline,   ///< Natural cubic spline (C2 continuous).
+    kPchip          ///< Monotone piecewise cubic Hermite (Fritsch-Carlson).
+};
+
+/**
+ * @class MomentumInterpolator
+ * @brief Evaluates a tabulated momentum distribution rho(p) at arbitrary momenta.
+ *
+ * The interpolator is built once from the <momentum, probability density> table
+ * produced by MomentumDataLoader (or from two columns of the same length) and
+ * stores every segment as a cubic polynomial in Horner form, so all methods share
+ * one evaluation kernel. Equidistant grids are detected on construction and use
+ * an O(1) index computation; other grids use a branch-free binary search.
+ * Momenta outside the tabulated range evaluate to zero.
+ */
+class MomentumInterpolator {
+public:
+    /**
+     * @brief Default constructor creating an empty interpolator that evaluates to zero.
+     */
+    MomentumInterpolator() = default;
+
+    /**
+     * @brief Builds the interpolator from <momentum, probability density> pairs.
+     *
+     * @param data Table as returned by MomentumDataLoader::LoadData, sorted by momentum.
+     * @param method Interpolation scheme to use between the tabulated points.
+     */
+    MomentumInterpolator(
+        const std::vector<std::pair<float, float>>& data,
+        InterpolationMethod method = InterpolationMethod::kPchip);
+
+    /**
+     * @brief Builds the interpolator from separate momentum and density columns.
+     *
+     * @param momenta Strictly increasing momentum values.
+     * @param densities Probability densities corresponding to the momenta.
+     * @param method Interpolation scheme to use between the tabulated points.
+     */
+    MomentumInterpolator(
+        const std::vector<double>& momenta,
+        const std::vector<double>& densities,
+        InterpolationMethod method = InterpolationMethod::kPchip);
+
+    /**
+     * @brief Evaluates the distribution at a single momentum.
+     *
+     * @param momentum Momentum at which to evaluate the distribution.
+     * @return Interpolated probability density, or zero outside the table range.
+     */
+    double Evaluate(double momentum) const;
+
+    /**
+     * @brief Evaluates the distribution for a batch of momenta.
+     *
+     * @param momenta Pointer to the momenta to evaluate.
+     * @param densities Pointer to the output buffer receiving the densities.
+     * @param count Number of momenta in the batch.
+     */
+    void Evaluate(const double* momenta, double* densities, std::size_t count) const;
+
+    /**
+     * @brief Evaluates the distribution for a batch of momenta.
+     *
+     * @param momenta Momenta to evaluate.
+     * @return Interpolated probability densities, one per momentum.
+     */
+    std::vector<double> Evaluate(const std::vector<double>& momenta) const;
+
+    /**
+     * @brief Evaluates the distribution for a batch of momenta sorted in ascending order.
+     *
+     * Walks the segments alongside the momenta instead of searching for each one,
+     * so resampling onto another grid costs O(Size() + count).
+     *
+     * @param momenta Pointer to the ascending momenta to evaluate.
+     * @param densities Pointer to the output buffer receiving the densities.
+     * @param count Number of momenta in the batch.
+     */
+    void EvaluateSorted(const double* momenta, double* densities, std::size_t count) const;
+
+    /**
+     * @brief Checks whether the interpolator holds a usable table.
+     */
+    bool IsValid() const { return knots.size() >= 2; }
+
+    /**
+     * @brief Checks whether the tabulated momenta are equidistant.
+     */
+    bool IsUniformGrid() const { return is_uniform; }
+
+    /**
+     * @brief Returns the number of tabulated points.
+     */
+    std::size_t Size() const { return knots.size(); }
+
+    /**
+     * @brief Returns the smallest tabulated momentum.
+     */
+    double MinMomentum() const { return IsValid() ? knots.front() : 0.; }
+
+    /**
+     * @brief Returns the largest tabulated momentum.
+     */
+    double MaxMomentum() const { return IsValid() ? knots.back() : 0.; }
+
+    /**
+     * @brief Returns the interpolation scheme in use.
+     */
+    InterpolationMethod Method() const { return method; }
+
+    /**
+     * @brief Returns the tabulated momenta (segment boundaries).
+     */
+    const std::vector<double>& Knots() const { return knots; }
+
+    /**
+     * @brief Returns the polynomial a + b*t + c*t^2 + d*t^3 of a segment, with t 
+     *        measured from the segment's left knot.
+     *
+     * @param segment Segment index in [0, Size() - 2].
+     * @param a Receives the constant coefficient.
+     * @param b Receives the linear coefficient.
+     * @param c Receives the quadratic coefficient.
+     * @param d Receives the cubic coefficient.
+     */
+    void SegmentCoefficients(
+        std::size_t segment, double& a, double& b, double& c, double& d) const {
+        a = coeff_a[segment];
+        b = coeff_b[segment];
+        c = coeff_c[segment];
+        d = coeff_d[segment];
+    }
+
+private:
+    InterpolationMethod method = InterpolationMethod::kPchip;
+    std::vector<double> knots;      // Tabulated momenta
+    std::vector<double> coeff_a;    // Segment value at the left knot
+    std::vector<double> coeff_b;    // Linear coefficient of each segment
+    std::vector<double> coeff_c;    // Quadratic coefficient of each segment
+    std::vector<double> coeff_d;    // Cubic coefficient of each segment
+    bool is_uniform = false;        // True if the knots are equidistant
+    double inv_step = 0.;           // Inverse knot spacing for uniform grids
+
+    /**
+     * @brief Validates the table and builds the segment coefficients.
+     *
+     * @param densities Probability densities at the knots.
+     */
+    void Build(const std::vector<double>& densities);
+
+    /**
+     * @brief Computes segment coefficients from the knot slopes (cubic Hermite form).
+     *
+     * @param densities Probability densities at the knots.
+     * @param slopes First derivatives at the knots.
+     */
+    void BuildFromSlopes(
+        const std::vector<double>& densities, const std::vector<double>& slopes);
+
+    /**
+     * @brief Computes natural cubic spline coefficients.
+     *
+     * @param densities Probability densities at the knots.
+     */
+    void BuildCubicSpline(const std::vector<double>& densities);
+
+    /**
+     * @brief Computes shape-preserving knot slopes for PCHIP interpolation.
+     *
+     * @param densities Probability densities at the knots.
+     * @return First derivatives at the knots.
+     */
+    std::vector<double> PchipSlopes(const std::vector<double>& densities) const;
+
+    /**
+     * @brief Detects whether the knots are equidistant within float precision.
+     */
+    void DetectUniformGrid();
+
+    /**
+     * @brief Finds the segment index whose left knot is the closest one below the momentum.
+     *
+     * @param momentum Momentum inside the table range.
+     * @return Segment index in [0, Size() - 2].
+     */
+    std::size_t FindSegment(double momentum) const;
+};
+
+#endif // COMMON_MOMENTUM_INTERPOLATOR_H
@@ -0,0 +1,135 @@
+#ifndef COMMON_MOMENTUM_RESAMPLER_H
+#define COMMON_MOMENTUM_RESAMPLER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <utility>  // For std::pair
+#include "momentum_interpolator.h"
+
+/**
+ * @class MomentumResampler
+ * @brief Maps momentum distributions tabulated on different grids onto one
+ *        shared momentum grid.
+ *
+ * Tables are registered with AddTable (loader output for the ^3He inputs, or
+ * the momentum and density columns produced by MomentumDistributionCalculator
+ * for the deuteron models) and resampled together by a single call to Resample.
+ * The results are stored contiguously, one row per table, so ratios, differences
+ * and combined plots become element-wise loops over rows of equal length.
+ */
+class MomentumResampler {
+public:
+    /**
+     * @brief Constructs a resampler for a given target grid.
+     *
+     * @param grid Ascending momenta of the shared grid.
+     * @param method Interpolation scheme used to evaluate the tables on the grid.
+     */
+    explicit MomentumResampler(
+        std::vector<double> grid,
+        InterpolationMethod method = InterpolationMethod::kPchip);
+
+    /**
+     * @brief Creates an equidistant momentum grid.
+     *
+     * @param min_momentum First grid point.
+     * @param max_momentum Last grid point.
+     * @param points Number of grid points (at least two).
+     * @return The grid momenta.
+     */
+    static std::vector<double> UniformGrid(
+        double min_momentum, double max_momentum, std::size_t points);
+
+    /**
+     * @brief Registers a table in the <momentum, probability density> layout of MomentumDataLoader.
+     *
+     * @param label Name identifying the table (e.g. the input file or model name).
+     * @param data Table sorted by momentum.
+     * @return Row index of the table in the resampled output.
+     */
+    std::size_t AddTable(
+        const std::string& label, const std::vector<std::pair<float, float>>& data);
+
+    /**
+     * @brief Registers a table given as separate momentum and density columns.
+     *
+     * @param label Name identifying the table (e.g. the input file or model name).
+     * @param momenta Strictly increasing momentum values.
+     * @param densities Probability densities corresponding to the momenta.
+     * @return Row index of the table in the resampled output.
+     */
+    std::size_t AddTable(
+        const std::string& label,
+        const std::vector<double>& momenta,
+        const std::vector<double>& densities);
+
+    /**
+     * @brief Evaluates all registered tables on the shared grid.
+     *
+     * Each table is walked once alongside the ascending grid, so the cost is
+     * linear in the table and grid sizes.
+     */
+    void Resample();
+
+    /**
+     * @brief Returns the shared momentum grid.
+     */
+    const std::vector<double>& Grid() const { return grid; }
+
+    /**
+     * @brief Returns the number of registered tables.
+     */
+    std::size_t TableCount() const { return tables.size(); }
+
+    /**
+     * @brief Returns the label of a registered table.
+     *
+     * @param table Row index returned by AddTable.
+     */
+    const std::string& Label(std::size_t table) const { return labels[table]; }
+
+    /**
+     * @brief Returns the resampled densities of a table (valid after Resample).
+     *
+     * @param table Row index returned by AddTable.
+     * @return Pointer to Grid().size() densities.
+     */
+    const double* Row(std::size_t table) const { return values.data() + table * grid.size(); }
+
+    /**
+     * @brief Returns the resampled densities of a table as a vector.
+     *
+     * @param table Row index returned by AddTable.
+     */
+    std::vector<double> RowVector(std::size_t table) const;
+
+    /**
+     * @brief Computes the element-wise ratio of two resampled tables.
+     *
+     * Grid points where the denominator vanishes yield zero.
+     *
+     * @param numerator Row index of the numerator table.
+     * @param denominator Row index of the denominator table.
+     * @return Ratio on the shared grid.
+     */
+    std::vector<double> Ratio(std::size_t numerator, std::size_t denominator) const;
+
+    /**
+     * @brief Computes the element-wise difference of two resampled tables.
+     *
+     * @param minuend Row index of the table to subtract from.
+     * @param subtrahend Row index of the table to subtract.
+     * @return Difference on the shared grid.
+     */
+    std::vector<double> Difference(std::size_t minuend, std::size_t subtrahend) const;
+
+private:
+    std::vector<double> grid;                   // Shared ascending momentum grid
+    InterpolationMethod method;                 // Interpolation scheme for all tables
+    std::vector<MomentumInterpolator> tables;   // Registered source tables
+    std::vector<std::string> labels;            // Label of each registered table
+    std::vector<double> values;                 // Resampled rows, one per table
+};
+
+#endif // COMMON_MOMENTUM_RESAMPLER_H
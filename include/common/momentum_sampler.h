@@ -0,0 +1,140 @@
+#ifndef COMMON_MOMENTUM_SAMPLER_H
+#define COMMON_MOMENTUM_SAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @class MomentumSampler
+ * @brief Draws nucleon momenta from a tabulated momentum distribution.
+ *
+ * The density is taken as piecewise linear between the tabulated points, so
+ * the cumulative distribution is piecewise quadratic and is inverted exactly
+ * within each segment. Sampling by inverse CDF needs one uniform number and
+ * one binary search per momentum, and the sampled momenta follow the same
+ * distribution that is plotted and written to the data files. Negative
+ * densities (numerical noise in the tails) are treated as zero.
+ *
+ * Lookups are constant-time where possible: on an equidistant momentum grid
+ * the segment of a momentum is computed directly, and a guide table of
+ * probability buckets gives the starting segment for the quantile search.
+ */
+class MomentumSampler {
+public:
+    /**
+     * @brief Default constructor creating an empty sampler.
+     */
+    MomentumSampler() = default;
+
+    /**
+     * @brief Builds the sampler from separate momentum and density columns.
+     *
+     * @param momenta Strictly increasing momentum values.
+     * @param densities Probability densities corresponding to the momenta.
+     */
+    MomentumSampler(
+        const std::vector<double>& momenta,
+        const std::vector<double>& densities);
+
+    /**
+     * @brief Rebuilds the sampler from two columns held in memory.
+     *
+     * @param momenta Pointer to the strictly increasing momenta.
+     * @param densities Pointer to the probability densities.
+     * @param count Number of points in both columns (at least two).
+     * @return True if the table is usable, false otherwise (the sampler is then empty).
+     */
+    bool Build(const double* momenta, const double* densities, std::size_t count);
+
+    /**
+     * @brief Checks whether the sampler holds a distribution with non-zero norm.
+     */
+    bool IsValid() const { return norm > 0.; }
+
+    /**
+     * @brief Integral of the tabulated density before normalisation.
+     */
+    double Norm() const { return norm; }
+
+    /**
+     * @brief Lower end of the tabulated momentum range.
+     */
+    double MinMomentum() const { return knots.empty() ? 0. : knots.front(); }
+
+    /**
+     * @brief Upper end of the tabulated momentum range.
+     */
+    double MaxMomentum() const { return knots.empty() ? 0. : knots.back(); }
+
+    /**
+     * @brief Normalised density at a momentum (linear between the tabulated points).
+     *
+     * @param momentum Momentum at which to evaluate the density.
+     * @return Density divided by the norm, or zero outside the table range.
+     */
+    double Density(double momentum) const;
+
+    /**
+     * @brief Cumulative distribution function.
+     *
+     * @param momentum Momentum up to which the distribution is integrated.
+     * @return Probability of a momentum below the given one, in [0, 1].
+     */
+    double Cdf(double momentum) const;
+
+    /**
+     * @brief Inverse of the cumulative distribution function.
+     *
+     * @param probability Probability in [0, 1]; values outside are clamped.
+     * @return Momentum below which the given fraction of the distribution lies.
+     */
+    double Quantile(double probability) const;
+
+    /**
+     * @brief Draws one momentum.
+     *
+     * @param engine Random engine providing the uniform numbers.
+     * @return Sampled momentum.
+     */
+    double Sample(std::mt19937_64& engine) const;
+
+    /**
+     * @brief Draws a batch of momenta.
+     *
+     * @param engine Random engine providing the uniform numbers.
+     * @param momenta Output buffer receiving the sampled momenta.
+     * @param count Number of momenta to draw.
+     */
+    void Sample(std::mt19937_64& engine, double* momenta, std::size_t count) const;
+
+    /**
+     * @brief Draws a reproducible batch of momenta from a seed.
+     *
+     * @param seed Seed of the random engine.
+     * @param count Number of momenta to draw.
+     * @return Sampled momenta.
+     */
+    std::vector<double> Sample(std::uint64_t seed, std::size_t count) const;
+
+private:
+    std::vector<double> knots;      // Tabulated momenta
+    std::vector<double> densities;  // Densities at the knots (negative values clipped)
+    std::vector<double> cumulative; // Unnormalised integral up to each knot
+    double norm = 0.;               // Total integral of the density
+    double inverse_step = 0.;       // Inverse knot spacing of an equidistant grid, zero otherwise
+    std::vector<std::size_t> guide; // First candidate segment of each probability bucket
+
+    /**
+     * @brief Index of the segment [knots[i], knots[i+1]] holding a momentum.
+     */
+    std::size_t MomentumSegment(double momentum) const;
+
+    /**
+     * @brief Index of the segment [knots[i], knots[i+1]] holding a cumulative value.
+     */
+    std::size_t FindSegment(double target) const;
+};
+
+#endif // COMMON_MOMENTUM_SAMPLER_H
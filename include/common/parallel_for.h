@@ -0,0 +1,41 @@
+#ifndef COMMON_PARALLEL_FOR_H
+#define COMMON_PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs body(i) for every i in [0, count) on up to the given number of threads.
+ *
+ * The indices are handed out one at a time, so uneven work is balanced. With a
+ * single thread, the body runs on the calling thread in ascending order.
+ *
+ * @param count Number of indices.
+ * @param threads Maximum number of threads; zero is treated as one.
+ * @param body Function called once per index; it must be safe to call concurrently.
+ */
+inline void ParallelFor(
+    std::size_t count, std::size_t threads, const std::function<void(std::size_t)>& body)
+{
+    threads = std::min(std::max<std::size_t>(threads, 1), count);
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {body(i);}
+        return;
+    }
+    std::atomic<std::size_t> next(0);
+    std::vector<std::thread> pool;
+    for (std::size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&]() {
+            for (std::size_t i = next++; i < count; i = next++) {body(i);}
+        });
+    }
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+}
+
+#endif // COMMON_PARALLEL_FOR_H
@@ -0,0 +1,73 @@
+#ifndef COMMON_PDF_WRITER_H
+#define COMMON_PDF_WRITER_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @class PdfWriter
+ * @brief Minimal streaming writer for multi-page PDF documents.
+ *
+ * Pages are written to the file as soon as they are added, so a document of
+ * hundreds of plots never has to be held in memory. Each page is a compressed
+ * content stream of PDF drawing operators; text uses the standard Helvetica
+ * font, which every PDF viewer provides without embedding. The page tree, the
+ * catalog and the cross-reference table are written when the document is closed.
+ */
+class PdfWriter {
+public:
+    /**
+     * @brief Closes the document if it is still open.
+     */
+    ~PdfWriter();
+
+    /**
+     * @brief Creates the file and writes the document header.
+     *
+     * @param file_path Path of the PDF file.
+     * @return True if the file could be created.
+     */
+    bool Open(const std::string& file_path);
+
+    /**
+     * @brief Appends a page to the open document.
+     *
+     * @param width Page width in points.
+     * @param height Page height in points.
+     * @param content Content stream of the page (PDF operators, font resource /F1).
+     * @return True if the page was written.
+     */
+    bool AddPage(double width, double height, const std::string& content);
+
+    /**
+     * @brief Writes the page tree and the cross-reference table and closes the file.
+     *
+     * @return True if the complete document was written.
+     */
+    bool Close();
+
+    /**
+     * @brief Checks whether a document is open.
+     */
+    bool IsOpen() const { return file.is_open(); }
+
+    /**
+     * @brief Returns the width of a text in Helvetica, in units of the font size.
+     */
+    static double TextWidth(const std::string& text);
+
+private:
+    std::ofstream file;                     // Document being written
+    std::string path;                       // Path of the document, for messages
+    std::vector<std::size_t> offsets;       // Byte offset of every object, by number - 1
+    std::vector<int> pages;                 // Object numbers of the page objects
+
+    /**
+     * @brief Starts the object with the given number and records its offset.
+     */
+    void BeginObject(int number);
+};
+
+#endif // COMMON_PDF_WRITER_H
@@ -0,0 +1,117 @@
+#ifndef COMMON_PLOT_BACKEND_H
+#define COMMON_PLOT_BACKEND_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @struct PlotCurve
+ * @brief One curve of a plot together with its drawing style.
+ *
+ * Colours and line styles follow the ROOT conventions, so the same description
+ * renders alike with every backend.
+ */
+struct PlotCurve {
+    std::string label;          ///< Legend label; curves without a label get no legend entry.
+    std::vector<double> x;      ///< Abscissae.
+    std::vector<double> y;      ///< Ordinates.
+    int color = 1;              ///< Colour index (1 black, 2 red, 3 green, 4 blue, 5 yellow, 6 magenta, ...).
+    int line_style = 1;         ///< Line style (1 solid, 2 dashed, 3 dotted, 4 dash-dotted).
+    int line_width = 1;         ///< Line width in pixels.
+    bool draw_line = true;      ///< Connect the points with a line.
+    bool draw_markers = false;  ///< Draw a filled circle at every point.
+    double marker_size = 0.7;   ///< Marker size (1 corresponds to 8 pixels).
+};
+
+/**
+ * @struct PlotSpec
+ * @brief Backend-independent description of a line plot.
+ */
+struct PlotSpec {
+    std::string canvas_title;   ///< Title of the canvas (window) the plot is drawn on.
+    std::string title;          ///< Plot title shown above the frame.
+    std::string x_title;        ///< Title of the x axis.
+    std::string y_title;        ///< Title of the y axis.
+    double x_min = 0.;          ///< Lower end of the x axis.
+    double x_max = 0.;          ///< Upper end of the x axis; automatic range if not above x_min.
+    double y_min = 0.;          ///< Lower end of the y axis.
+    double y_max = 0.;          ///< Upper end of the y axis; automatic range if not above y_min.
+    bool show_legend = false;   ///< Draw a legend in the upper right corner.
+    int width = 800;            ///< Image width in pixels.
+    int height = 600;           ///< Image height in pixels.
+    std::vector<PlotCurve> curves;  ///< Curves in drawing order.
+};
+
+/**
+ * @class PlotBackend
+ * @brief Interface of the renderers that turn a PlotSpec into an image file.
+ *
+ * Two backends are available: "root", which draws with ROOT graphics, and
+ * "lite", a built-in renderer writing SVG or PNG files without any external
+ * library. The plot generators only build PlotSpec objects and hand them to
+ * the backend selected at runtime.
+ */
+class PlotBackend {
+public:
+    virtual ~PlotBackend() = default;
+
+    /**
+     * @brief Renders a plot and saves it.
+     *
+     * @param spec Description of the plot.
+     * @param output_path Path of the image file; its extension selects the format.
+     * @return True if the file was written.
+     */
+    virtual bool Render(const PlotSpec& spec, const std::string& output_path) = 0;
+
+    /**
+     * @brief Opens a multi-page document (PDF) for the following AddPage calls.
+     *
+     * The document file is created once and the pages are streamed into it,
+     * which is much cheaper than writing one image file per plot.
+     *
+     * @param output_path Path of the document, normally with the extension ".pdf".
+     * @return True if the document was opened.
+     */
+    virtual bool OpenDocument(const std::string& output_path) = 0;
+
+    /**
+     * @brief Renders a plot as the next page of the open document.
+     *
+     * @param spec Description of the plot.
+     * @return True if the page was written.
+     */
+    virtual bool AddPage(const PlotSpec& spec) = 0;
+
+    /**
+     * @brief Completes and closes the open document.
+     *
+     * @return True if the document was written completely.
+     */
+    virtual bool CloseDocument() = 0;
+
+    /**
+     * @brief Returns the name under which the backend is selected.
+     */
+    virtual const char* Name() const = 0;
+};
+
+/**
+ * @brief Returns the backend name given by the PLOT_BACKEND environment
+ *        variable, or "root" if it is not set.
+ */
+std::string DefaultPlotBackendName();
+
+/**
+ * @brief Creates a plot backend by name.
+ *
+ * The "root" backend is a proxy that loads the ROOT plot plugin on its first
+ * Render call and falls back to the lite backend if the plugin is missing.
+ *
+ * @param name "root" or "lite" ("svg" and "png" are accepted for "lite").
+ * @return The backend, or the lite backend with a warning for unknown names.
+ */
+std::unique_ptr<PlotBackend> CreatePlotBackend(const std::string& name);
+
+#endif // COMMON_PLOT_BACKEND_H
@@ -0,0 +1,46 @@
+#ifndef COMMON_PLOT_CANVAS_H
+#define COMMON_PLOT_CANVAS_H
+
+#include <string>
+
+class TCanvas;
+
+/**
+ * @class PlotCanvas
+ * @brief Provides the single ROOT canvas shared by all plot generators.
+ *
+ * Creating a TCanvas is far more expensive than drawing a few graphs on it, and
+ * on display-less nodes it should never try to open a window. The plot
+ * generators therefore switch ROOT into batch mode once and draw every plot on
+ * one pooled canvas, which is cleared and retitled for each new plot. The canvas
+ * itself is registered with ROOT, which deletes it at exit.
+ */
+class PlotCanvas {
+public:
+    static constexpr int DEFAULT_WIDTH = 800;   // Canvas width in pixels
+    static constexpr int DEFAULT_HEIGHT = 600;  // Canvas height in pixels
+
+    /**
+     * @brief Switches ROOT into batch mode, so no graphics windows are opened.
+     */
+    static void EnableBatchMode();
+
+    /**
+     * @brief Returns the pooled canvas, cleared and prepared for a new plot.
+     *
+     * The canvas is created on the first call and reused afterwards. Everything
+     * drawn on it for the previous plot is removed. Objects drawn on the canvas
+     * remain owned by the caller, which clears the canvas after saving the plot
+     * and before freeing them, so the canvas never refers to deleted objects.
+     *
+     * @param title Title of the canvas.
+     * @param width Canvas width in pixels.
+     * @param height Canvas height in pixels.
+     * @return The canvas, set as the current pad.
+     */
+    static TCanvas* Acquire(
+        const std::string& title,
+        int width = DEFAULT_WIDTH, int height = DEFAULT_HEIGHT);
+};
+
+#endif // COMMON_PLOT_CANVAS_H
@@ -0,0 +1,49 @@
+#ifndef COMMON_PNG_WRITER_H
+#define COMMON_PNG_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class PngWriter
+ * @brief Minimal PNG encoder for 8-bit RGB images without external libraries.
+ *
+ * The image data is compressed with deflate using the fixed Huffman code and a
+ * greedy LZ77 match search, which is compact for plots made of large uniform
+ * areas. Checksums are CRC-32 for the PNG chunks and Adler-32 for the zlib stream.
+ */
+class PngWriter {
+public:
+    /**
+     * @brief Writes an RGB image to a PNG file.
+     *
+     * @param file_path Path of the output file.
+     * @param width Image width in pixels.
+     * @param height Image height in pixels.
+     * @param rgb Pixel data, three bytes per pixel, rows from top to bottom.
+     * @return True if the file was written.
+     */
+    static bool Write(
+        const std::string& file_path, int width, int height,
+        const std::vector<std::uint8_t>& rgb);
+
+    /**
+     * @brief Computes the CRC-32 (ISO 3309) of a byte range, continuing from a previous value.
+     */
+    static std::uint32_t Crc32(
+        const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0);
+
+    /**
+     * @brief Computes the Adler-32 checksum of a byte range.
+     */
+    static std::uint32_t Adler32(const std::uint8_t* data, std::size_t size);
+
+    /**
+     * @brief Compresses data into a zlib stream (fixed-Huffman deflate).
+     */
+    static std::vector<std::uint8_t> Compress(const std::vector<std::uint8_t>& data);
+};
+
+#endif // COMMON_PNG_WRITER_H
@@ -0,0 +1,104 @@
+#ifndef COMMON_QUERY_CLIENT_H
+#define COMMON_QUERY_CLIENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "query_protocol.h"
+
+/**
+ * @class QueryClient
+ * @brief Connection to a QueryServer for evaluating and sampling distributions.
+ *
+ * Each call sends one batch query and waits for its answer. The output buffer
+ * may be the input buffer. A connection is used by one thread at a time.
+ */
+class QueryClient {
+public:
+    /**
+     * @brief Constructor for an unconnected client.
+     */
+    QueryClient() = default;
+
+    /**
+     * @brief Destructor closing the connection.
+     */
+    ~QueryClient();
+
+    QueryClient(const QueryClient&) = delete;
+    QueryClient& operator=(const QueryClient&) = delete;
+
+    /**
+     * @brief Connects to a server, closing a previous connection.
+     *
+     * @param socket_path Path of the server's Unix domain socket.
+     * @return True if connected.
+     */
+    bool Connect(const std::string& socket_path);
+
+    /**
+     * @brief Closes the connection.
+     */
+    void Disconnect();
+
+    /**
+     * @brief Checks whether the client is connected.
+     */
+    bool IsConnected() const { return descriptor >= 0; }
+
+    /**
+     * @brief Evaluates the normalised density of a model.
+     *
+     * @param model Model name.
+     * @param momenta Momenta in GeV/c.
+     * @param densities Output buffer receiving the densities.
+     * @param count Number of momenta.
+     * @return True if the server answered the query.
+     */
+    bool Evaluate(const std::string& model, const double* momenta, double* densities, std::size_t count);
+
+    /**
+     * @brief Evaluates the cumulative distribution function of a model.
+     */
+    bool Cdf(const std::string& model, const double* momenta, double* probabilities, std::size_t count);
+
+    /**
+     * @brief Evaluates the inverse cumulative distribution function of a model.
+     */
+    bool Quantile(const std::string& model, const double* probabilities, double* momenta, std::size_t count);
+
+    /**
+     * @brief Draws a reproducible batch of momenta from a model.
+     *
+     * @param model Model name.
+     * @param seed Seed of the server's random engine.
+     * @param momenta Output buffer receiving the sampled momenta.
+     * @param count Number of momenta to draw.
+     * @return True if the server answered the query.
+     */
+    bool Sample(const std::string& model, std::uint64_t seed, double* momenta, std::size_t count);
+
+    /**
+     * @brief Status of the last query.
+     */
+    QueryStatus LastStatus() const { return last_status; }
+
+    /**
+     * @brief Model set version that answered the last query.
+     */
+    std::uint64_t LastVersion() const { return last_version; }
+
+private:
+    int descriptor = -1;                    // Connected socket
+    QueryStatus last_status = QUERY_OK;     // Status of the last response
+    std::uint64_t last_version = 0;         // Version of the last response
+
+    /**
+     * @brief Sends a query and receives its answer.
+     */
+    bool Query(
+        QueryOperation operation, const std::string& model, const double* input,
+        double* output, std::size_t count, std::uint64_t seed);
+};
+
+#endif // COMMON_QUERY_CLIENT_H
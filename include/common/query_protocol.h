@@ -0,0 +1,72 @@
+#ifndef COMMON_QUERY_PROTOCOL_H
+#define COMMON_QUERY_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file query_protocol.h
+ * @brief Binary protocol of the momentum distribution query server.
+ *
+ * A client sends a QueryRequest followed by the request payload and receives
+ * a QueryResponse followed by the response payload; any number of queries may
+ * be sent over one connection. Payloads are arrays of 64-bit doubles. All
+ * fields use the byte order of the machine, since server and clients share a
+ * host through a Unix domain socket.
+ *
+ * Operations and their payloads:
+ *  - QUERY_EVALUATE: count momenta in, count normalised densities out.
+ *  - QUERY_CDF: count momenta in, count cumulative probabilities out.
+ *  - QUERY_QUANTILE: count probabilities in, count momenta out.
+ *  - QUERY_SAMPLE: no payload in, count momenta drawn with the given seed out.
+ */
+
+/// Magic value opening every request and response ("NMQ1").
+constexpr std::uint32_t QUERY_MAGIC = 0x31514d4eu;
+
+/// Largest number of points in one query.
+constexpr std::uint64_t QUERY_MAX_POINTS = std::uint64_t(1) << 24;
+
+/// Length of the zero-padded model name in a request.
+constexpr std::size_t QUERY_MODEL_NAME_SIZE = 48;
+
+/// Operations understood by the server.
+enum QueryOperation : std::uint32_t {
+    QUERY_EVALUATE = 1,
+    QUERY_CDF = 2,
+    QUERY_QUANTILE = 3,
+    QUERY_SAMPLE = 4,
+};
+
+/// Status codes of a response; no payload follows unless the status is QUERY_OK.
+enum QueryStatus : std::uint32_t {
+    QUERY_OK = 0,
+    QUERY_UNKNOWN_MODEL = 1,
+    QUERY_BAD_REQUEST = 2,
+    QUERY_TOO_LARGE = 3,
+};
+
+/**
+ * @struct QueryRequest
+ * @brief Fixed-size header of a query.
+ */
+struct QueryRequest {
+    std::uint32_t magic;                    ///< QUERY_MAGIC.
+    std::uint32_t operation;                ///< One of QueryOperation.
+    char model[QUERY_MODEL_NAME_SIZE];      ///< Model name, zero-padded.
+    std::uint64_t count;                    ///< Number of points.
+    std::uint64_t seed;                     ///< Seed of QUERY_SAMPLE, ignored otherwise.
+};
+
+/**
+ * @struct QueryResponse
+ * @brief Fixed-size header of a response.
+ */
+struct QueryResponse {
+    std::uint32_t magic;                    ///< QUERY_MAGIC.
+    std::uint32_t status;                   ///< One of QueryStatus.
+    std::uint64_t count;                    ///< Number of doubles in the payload.
+    std::uint64_t version;                  ///< Model set version; increases on every reload.
+};
+
+#endif // COMMON_QUERY_PROTOCOL_H
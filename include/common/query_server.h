@@ -0,0 +1,101 @@
+#ifndef COMMON_QUERY_SERVER_H
+#define COMMON_QUERY_SERVER_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "momentum_sampler.h"
+#include "query_protocol.h"
+
+/**
+ * @class QueryServer
+ * @brief Answers batch queries on momentum distributions over a Unix domain socket.
+ *
+ * The server holds a catalog of precompiled distributions (MomentumSampler
+ * objects by model name) and serves the operations of query_protocol.h. Every
+ * connection is handled by its own thread, which reuses one buffer for all
+ * its queries and answers them in place, so a query costs two reads, the
+ * evaluation and one write.
+ *
+ * A new catalog can be published at any time, for example after the model
+ * configuration changed. Queries in progress finish on the catalog they
+ * started with; the next query of every connection sees the new one.
+ */
+class QueryServer {
+public:
+    /// Distributions by model name.
+    using Catalog = std::map<std::string, MomentumSampler>;
+
+    /**
+     * @brief Constructor for a server without models.
+     */
+    QueryServer() = default;
+
+    /**
+     * @brief Destructor closing the listening socket and removing its file.
+     */
+    ~QueryServer();
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    /**
+     * @brief Replaces the served catalog and increases the version.
+     *
+     * @param catalog Distributions to serve from the next query on.
+     */
+    void Publish(Catalog catalog);
+
+    /**
+     * @brief Returns the version of the current catalog (zero before the first Publish).
+     */
+    std::uint64_t Version() const;
+
+    /**
+     * @brief Creates the socket file (replacing a stale one) and starts listening.
+     *
+     * @param socket_path Path of the Unix domain socket.
+     * @return True if the server listens.
+     */
+    bool Listen(const std::string& socket_path);
+
+    /**
+     * @brief Accepts connections until the listening socket fails.
+     *
+     * The connection threads are detached, so the server must live as long
+     * as the process (it normally runs until the process is stopped).
+     *
+     * @return False after an error of the listening socket.
+     */
+    bool Run();
+
+    /**
+     * @brief Answers one query in place.
+     *
+     * @param request Validated request header.
+     * @param values Payload of the request, replaced by the payload of the response.
+     * @param catalog Catalog to answer from.
+     * @return Status of the response.
+     */
+    static QueryStatus Answer(
+        const QueryRequest& request, std::vector<double>& values, const Catalog& catalog);
+
+private:
+    struct Snapshot {
+        Catalog catalog;
+        std::uint64_t version;
+    };
+
+    std::shared_ptr<const Snapshot> current;    // Served catalog (atomic access only)
+    int listen_descriptor = -1;                 // Listening socket
+    std::string path;                           // Path of the socket file
+
+    /**
+     * @brief Serves all queries of one connection and closes it.
+     */
+    void ServeConnection(int descriptor);
+};
+
+#endif // COMMON_QUERY_SERVER_H
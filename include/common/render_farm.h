@@ -0,0 +1,244 @@
+#ifndef COMMON_RENDER_FARM_H
+#define COMMON_RENDER_FARM_H
+
+#include "curve_downsampler.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+/**
+ * @struct RenderSeries
+ * @brief Non-owning view of one data series submitted for rendering.
+ */
+struct RenderSeries {
+    std::string label;      ///< Legend label of the series.
+    const double* x;        ///< Abscissae (momenta).
+    const double* y;        ///< Ordinates (densities).
+    std::size_t size;       ///< Number of points.
+};
+
+/**
+ * @struct RenderRequest
+ * @brief One plot to draw, as passed to the render callback.
+ */
+struct RenderRequest {
+    int kind;                           ///< Application-defined plot type.
+    std::string title;                  ///< Plot title.
+    std::string output_path;            ///< File the plot is saved to.
+    std::vector<RenderSeries> series;   ///< Data series of the plot.
+};
+
+/**
+ * @struct RenderJob
+ * @brief Plot job as stored in a shared-memory slot.
+ *
+ * The job holds everything a worker needs to draw one plot: the output path,
+ * a title, an application-defined plot kind and up to MAX_SERIES data series.
+ * The points of all series are stored back to back after the job header, first
+ * the capacity abscissae and then the capacity ordinates, so a slot occupies
+ * SlotSize(capacity) bytes.
+ */
+struct RenderJob {
+    static constexpr std::size_t MAX_SERIES = 8;      ///< Series per plot.
+    static constexpr std::size_t MAX_TEXT = 256;      ///< Length of paths and titles.
+    static constexpr std::size_t MAX_LABEL = 64;      ///< Length of series labels.
+
+    int kind;                               ///< Application-defined plot type.
+    char title[MAX_TEXT];                   ///< Plot title.
+    char output_path[MAX_TEXT];             ///< File the plot is saved to.
+    std::size_t series_count;               ///< Number of series in the job.
+    char labels[MAX_SERIES][MAX_LABEL];     ///< Series labels.
+    std::size_t offsets[MAX_SERIES + 1];    ///< Series i occupies [offsets[i], offsets[i+1]).
+    std::size_t capacity;                   ///< Points of all series together.
+
+    /**
+     * @brief Returns the bytes of a slot holding jobs of the given capacity.
+     */
+    static std::size_t SlotSize(std::size_t capacity) {
+        return sizeof(RenderJob) + 2 * capacity * sizeof(double);
+    }
+
+    /**
+     * @brief Returns the abscissae of all series.
+     */
+    double* X() { return reinterpret_cast<double*>(this + 1); }
+    const double* X() const { return reinterpret_cast<const double*>(this + 1); }
+
+    /**
+     * @brief Returns the ordinates of all series.
+     */
+    double* Y() { return X() + capacity; }
+    const double* Y() const { return X() + capacity; }
+
+    /**
+     * @brief Returns the series i as a view into the job.
+     */
+    RenderSeries Series(std::size_t i) const {
+        return {labels[i], X() + offsets[i], Y() + offsets[i], offsets[i + 1] - offsets[i]};
+    }
+
+    /**
+     * @brief Returns the job as a request whose series are views into the job.
+     */
+    RenderRequest Request() const;
+};
+
+static_assert(sizeof(RenderJob) % alignof(double) == 0, "Points must follow RenderJob aligned");
+
+/**
+ * @class RenderFarm
+ * @brief Renders plot jobs in a pool of forked worker processes.
+ *
+ * ROOT graphics are not thread-safe, but separate processes can draw in
+ * parallel. The farm forks its workers once; each of them keeps its ROOT session
+ * (and pooled canvas) alive for all jobs it renders. Jobs travel through a fixed
+ * number of slots in an anonymous shared mapping, so the data computed by the
+ * parent is copied once into a slot and read there by the worker. Free and
+ * pending slots are tracked with process-shared semaphores. The slots are sized
+ * in Start() for the largest job expected, and series denser than the plot
+ * point limit are downsampled before they are copied.
+ *
+ * The render callback is independent of ROOT; it receives a RenderRequest and
+ * draws it with whatever plot generator it captures. It runs in the worker
+ * processes, or in the calling process for jobs no slot can hold and if no
+ * workers could be started. In process it reads the submitted series directly.
+ *
+ * Start the farm before the parent draws anything, so the workers inherit a
+ * process without open graphics resources.
+ */
+class RenderFarm {
+public:
+    /**
+     * @brief Callback drawing one job; returns true on success.
+     */
+    using RenderCallback = std::function<bool(const RenderRequest&)>;
+
+    static constexpr std::size_t DEFAULT_SLOT_POINTS = 4096;  ///< Slot size if unspecified.
+
+    /**
+     * @brief Constructor for a new RenderFarm object.
+     *
+     * @param workers Number of worker processes; zero renders in the calling process.
+     * @param callback Function drawing a job.
+     * @param slots Number of shared job slots; zero selects two per worker.
+     */
+    RenderFarm(std::size_t workers, RenderCallback callback, std::size_t slots = 0);
+
+    /**
+     * @brief Waits for outstanding jobs and stops the workers.
+     */
+    ~RenderFarm();
+
+    RenderFarm(const RenderFarm&) = delete;
+    RenderFarm& operator=(const RenderFarm&) = delete;
+
+    /**
+     * @brief Sets the number of points a series is reduced to before it is
+     *        copied into a slot; zero copies all points.
+     */
+    void SetMaxPlotPoints(std::size_t max_points) { downsampler.SetTargetPoints(max_points); }
+
+    /**
+     * @brief Maps the shared slots and forks the workers.
+     *
+     * @param series_points Points of the densest series to be submitted, before
+     *        downsampling; zero sizes the slots for DEFAULT_SLOT_POINTS points.
+     * @param series_per_job Largest number of series submitted in one job.
+     * @return True if the workers run, false if jobs will be rendered in process.
+     */
+    bool Start(std::size_t series_points = 0, std::size_t series_per_job = 1);
+
+    /**
+     * @brief Copies a plot job into a free slot and hands it to the workers.
+     *
+     * Blocks while all slots are busy. Jobs that do not fit into a slot are
+     * rendered in the calling process.
+     *
+     * @param kind Application-defined plot type passed to the callback.
+     * @param title Plot title.
+     * @param output_path File the plot is saved to.
+     * @param series Data series of the plot.
+     * @return False if the job was rendered in process and failed.
+     */
+    bool Submit(
+        int kind, const std::string& title, const std::string& output_path,
+        const std::vector<RenderSeries>& series);
+
+    /**
+     * @brief Waits until all submitted jobs are rendered; the workers keep running.
+     *
+     * Lets one farm serve several batches of jobs, e.g. the passes of watch mode.
+     *
+     * @return Number of jobs of the batch that failed.
+     */
+    std::size_t Drain();
+
+    /**
+     * @brief Waits until all submitted jobs are rendered and stops the workers.
+     *
+     * @return Number of jobs that failed.
+     */
+    std::size_t Finish();
+
+    /**
+     * @brief Returns the number of worker processes running.
+     */
+    std::size_t WorkerCount() const { return pids.size(); }
+
+private:
+    struct SharedState;                 // Queue bookkeeping in the shared mapping
+
+    std::size_t requested_workers;      // Workers to fork in Start()
+    std::size_t slot_count;             // Number of job slots
+    std::size_t slot_points = 0;        // Points a slot holds
+    std::size_t slot_size = 0;          // Bytes between consecutive slots
+    CurveDownsampler downsampler;       // Reduces dense series before copying
+    RenderCallback callback;            // Render function
+    std::vector<pid_t> pids;            // Running worker processes
+    void* mapping = nullptr;            // Shared state followed by the slots
+    std::size_t mapping_size = 0;       // Size of the mapping in bytes
+    std::size_t submitted = 0;          // Jobs handed to the workers
+    std::size_t local_failures = 0;     // Failures of jobs rendered in process
+
+    SharedState* State() const;
+    std::size_t* PendingRing() const;   // Slot indices waiting for a worker
+    std::size_t* FreeStack() const;     // Slot indices available for new jobs
+    RenderJob* Slot(std::size_t index) const;
+
+    /**
+     * @brief Returns true if a job with the given data fits into a slot.
+     */
+    bool JobFits(
+        const std::string& title, const std::string& output_path,
+        const std::vector<RenderSeries>& series) const;
+
+    /**
+     * @brief Fills a job from submitted data that fits into it.
+     */
+    static void FillJob(
+        RenderJob& job, int kind, const std::string& title,
+        const std::string& output_path, const std::vector<RenderSeries>& series);
+
+    /**
+     * @brief Renders a job in the calling process, counting a failure.
+     */
+    bool RenderLocally(
+        int kind, const std::string& title, const std::string& output_path,
+        const std::vector<RenderSeries>& series);
+
+    /**
+     * @brief Main loop of a worker process.
+     *
+     * @param parent Process that forked the worker.
+     */
+    void WorkerLoop(pid_t parent);
+
+    /**
+     * @brief Reaps workers that exited and returns the number still running.
+     */
+    std::size_t ReapWorkers();
+};
+
+#endif // COMMON_RENDER_FARM_H
@@ -0,0 +1,72 @@
+#ifndef COMMON_ROOT_PLOT_BACKEND_H
+#define COMMON_ROOT_PLOT_BACKEND_H
+
+#include <string>
+#include "plot_backend.h"
+
+/**
+ * @class RootPlotBackend
+ * @brief Plot backend drawing with ROOT graphics in batch mode.
+ *
+ * Every curve becomes a TGraph in a TMultiGraph, drawn on the pooled canvas
+ * of PlotCanvas. All ROOT objects are owned by the Render call and freed after
+ * the image is saved. Any format supported by TCanvas::SaveAs can be written.
+ *
+ * The class is built into the ROOT plot plugin (libroot_plot_backend.so) and
+ * is only reached through CreateRootPlotBackend after the plugin is loaded.
+ */
+class RootPlotBackend : public PlotBackend {
+public:
+    /**
+     * @brief Constructor for a new RootPlotBackend object.
+     *
+     * @param batch_mode If true, ROOT runs headless and never opens graphics windows.
+     */
+    explicit RootPlotBackend(bool batch_mode = true);
+
+    /**
+     * @brief Renders a plot with ROOT and saves it with TCanvas::SaveAs.
+     *
+     * @param spec Description of the plot.
+     * @param output_path Path of the image file.
+     * @return True once the canvas has been saved.
+     */
+    bool Render(const PlotSpec& spec, const std::string& output_path) override;
+
+    /**
+     * @brief Opens a multi-page document ("file.pdf[").
+     */
+    bool OpenDocument(const std::string& output_path) override;
+
+    /**
+     * @brief Draws a plot and prints it as the next page of the open document.
+     */
+    bool AddPage(const PlotSpec& spec) override;
+
+    /**
+     * @brief Closes the open document ("file.pdf]").
+     */
+    bool CloseDocument() override;
+
+    /**
+     * @brief Returns "root".
+     */
+    const char* Name() const override { return "root"; }
+
+private:
+    std::string document_path;  // Path of the open document; empty if none
+
+    /**
+     * @brief Draws a plot on the pooled canvas and prints it to a file or document.
+     */
+    bool Draw(const PlotSpec& spec, const std::string& print_path);
+};
+
+/**
+ * @brief Entry point of the ROOT plot plugin, looked up with dlsym.
+ *
+ * @return A new RootPlotBackend in batch mode, owned by the caller.
+ */
+extern "C" PlotBackend* CreateRootPlotBackend();
+
+#endif // COMMON_ROOT_PLOT_BACKEND_H
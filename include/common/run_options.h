@@ -0,0 +1,89 @@
+#ifndef COMMON_RUN_OPTIONS_H
+#define COMMON_RUN_OPTIONS_H
+
+#include "plot_backend.h"
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Reads a count from an environment variable; zero if it is unset.
+ *
+ * A value that is not a non-negative decimal integer is reported on the
+ * standard error and treated as unset.
+ *
+ * PLOT_WORKERS sets the number of render worker processes (zero renders in the
+ * main process), PLOT_MAX_POINTS the number of points drawn per curve (zero
+ * draws all points) and a non-zero PLOT_FORCE redraws plots that are up to date.
+ *
+ * @param name Name of the environment variable.
+ * @return The count, or zero if the variable is not set.
+ */
+std::size_t EnvironmentCount(const char* name);
+
+/**
+ * @struct RunOptions
+ * @brief Settings of a run of the deuteron, helium or serve command.
+ *
+ * Command line options override the defaults, which for the plot settings come
+ * from the environment variables of earlier versions.
+ */
+struct RunOptions {
+    std::string config_file = "src/deuteron/models_config.json";
+    std::string input_dir = "input";
+    std::string data_dir = "data";
+    std::string plot_dir = "plots";
+    std::string socket_path = "momentum_distribution.sock";
+    std::vector<std::string> models;    ///< Selected models or tables; empty selects all.
+    int steps = 0;                      ///< Grid intervals; zero keeps the calculator default.
+    double max_momentum = 0.;           ///< Grid end in GeV/c; zero keeps the calculator default.
+    std::size_t threads = 1;            ///< Threads computing distributions.
+    bool binary = false;                ///< Write binary instead of text distribution files.
+    bool watch = false;                 ///< Keep running and update the outputs on input changes.
+    bool publish = false;               ///< Publish the distributions as shared-memory tables.
+    bool plot = true;
+    std::string plot_backend = DefaultPlotBackendName();
+    std::size_t plot_workers = EnvironmentCount("PLOT_WORKERS");
+    std::size_t max_plot_points = EnvironmentCount("PLOT_MAX_POINTS");
+    bool force_plot = EnvironmentCount("PLOT_FORCE") > 0;
+    std::string plot_document =
+        std::getenv("PLOT_DOCUMENT") != nullptr ? std::getenv("PLOT_DOCUMENT") : "";
+};
+
+/**
+ * @brief Parses the options following the command.
+ *
+ * Invalid options and values are reported on the standard error.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @param first Index of the first option.
+ * @param options Settings updated from the options.
+ * @return False if an option or its value is invalid.
+ */
+bool ParseOptions(int argc, char* argv[], int first, RunOptions& options);
+
+/**
+ * @brief Prints the available commands and options on the standard error.
+ *
+ * @param program Name the program was started with.
+ */
+void PrintUsage(const std::string& program);
+
+/**
+ * @brief Checks whether a model or table is selected with --models.
+ */
+bool IsSelected(const RunOptions& options, const std::string& name);
+
+/**
+ * @brief Checks that every selected name is available; reports the unknown ones.
+ *
+ * @param selected Names given with --models.
+ * @param available Names of the models or tables that can be processed.
+ * @return True if all selected names are available.
+ */
+bool CheckSelection(
+    const std::vector<std::string>& selected, const std::vector<std::string>& available);
+
+#endif // COMMON_RUN_OPTIONS_H
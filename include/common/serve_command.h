@@ -0,0 +1,18 @@
+#ifndef COMMON_SERVE_COMMAND_H
+#define COMMON_SERVE_COMMAND_H
+
+#include "run_options.h"
+
+/**
+ * @brief Runs the serve command.
+ *
+ * Serves the selected deuteron models and 3He tables over a Unix domain socket.
+ * The catalog is rebuilt and swapped in whenever the configuration or an input
+ * table changes.
+ *
+ * @param options Settings of the run.
+ * @return Exit code of the program.
+ */
+int RunServer(const RunOptions& options);
+
+#endif // COMMON_SERVE_COMMAND_H
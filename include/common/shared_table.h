@@ -0,0 +1,129 @@
+#ifndef COMMON_SHARED_TABLE_H
+#define COMMON_SHARED_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct SharedTableHeader
+ * @brief Header at the start of a shared-memory distribution table.
+ *
+ * The momentum column follows the header, then the density column, both as
+ * 64-bit doubles. The magic is stored last when a table is published, so a
+ * table with a valid magic is complete.
+ */
+struct SharedTableHeader {
+    static constexpr char MAGIC[8] = {'N', 'M', 'D', 'S', 'H', 'M', '0', '1'}; ///< Layout version 1.
+
+    std::atomic<std::uint64_t> magic;       ///< MAGIC as a 64-bit word once the table is complete.
+    std::uint64_t header_size;              ///< Offset of the momentum column in bytes.
+    std::uint64_t version;                  ///< Publication number; increases with every republication.
+    std::uint64_t count;                    ///< Number of points in each column.
+    std::atomic<std::uint64_t> superseded;  ///< Non-zero once a newer version was published.
+    char name[48];                          ///< Table name, zero-padded.
+};
+
+/**
+ * @class SharedTable
+ * @brief Publishes distribution tables as POSIX shared memory and attaches to them.
+ *
+ * A table named "paris" is stored in the segment "/nmd_paris" (on Linux the
+ * file /dev/shm/nmd_paris). Readers map it read-only, so any number of
+ * processes share one copy of the data without copying it. Publishing a table
+ * again replaces the segment: new readers attach to the new version, and
+ * readers of the old one keep a valid mapping and see IsCurrent() turn false.
+ *
+ * Segments stay in place after the publishing process exits, until they are
+ * removed with Remove.
+ */
+class SharedTable {
+public:
+    /**
+     * @brief Constructor for a detached table.
+     */
+    SharedTable() = default;
+
+    /**
+     * @brief Destructor unmapping the table.
+     */
+    ~SharedTable();
+
+    SharedTable(const SharedTable&) = delete;
+    SharedTable& operator=(const SharedTable&) = delete;
+
+    /**
+     * @brief Publishes a distribution held as double columns.
+     *
+     * @param name Table name (letters, digits, '_', '-' and '.'; up to 47 characters).
+     * @param momenta Momentum column in GeV/c.
+     * @param densities Probability density column.
+     * @param count Number of points in both columns.
+     * @return Version of the published table, or zero on error.
+     */
+    static std::uint64_t Publish(
+        const std::string& name, const double* momenta, const double* densities, std::size_t count);
+
+    /**
+     * @brief Publishes a distribution held as float columns (stored as doubles).
+     */
+    static std::uint64_t Publish(
+        const std::string& name, const float* momenta, const float* densities, std::size_t count);
+
+    /**
+     * @brief Removes a published table; attached readers keep their mapping.
+     *
+     * @return True if the table existed.
+     */
+    static bool Remove(const std::string& name);
+
+    /**
+     * @brief Maps the current version of a published table read-only.
+     *
+     * @param name Table name.
+     * @return True if a complete table was attached.
+     */
+    bool Attach(const std::string& name);
+
+    /**
+     * @brief Unmaps the table.
+     */
+    void Detach();
+
+    /**
+     * @brief Checks whether a table is attached.
+     */
+    bool IsAttached() const { return header != nullptr; }
+
+    /**
+     * @brief Checks whether no newer version of the attached table was published.
+     */
+    bool IsCurrent() const { return header != nullptr && header->superseded.load(std::memory_order_acquire) == 0; }
+
+    /**
+     * @brief Publication version of the attached table.
+     */
+    std::uint64_t Version() const { return header != nullptr ? header->version : 0; }
+
+    /**
+     * @brief Number of points of the attached table.
+     */
+    std::size_t Size() const { return header != nullptr ? std::size_t(header->count) : 0; }
+
+    /**
+     * @brief Momentum column in shared memory.
+     */
+    const double* Momenta() const;
+
+    /**
+     * @brief Density column in shared memory.
+     */
+    const double* Densities() const;
+
+private:
+    const SharedTableHeader* header = nullptr;  // Start of the mapping
+    std::size_t mapping_size = 0;               // Size of the mapping in bytes
+};
+
+#endif // COMMON_SHARED_TABLE_H
@@ -0,0 +1,29 @@
+#ifndef DEUTERON_COMMAND_H
+#define DEUTERON_COMMAND_H
+
+#include "momentum_distribution.h"
+#include "../common/run_options.h"
+
+/**
+ * @brief Applies the --steps and --max-momentum options to a calculator.
+ *
+ * @param options Settings of the run.
+ * @param calculator Calculator whose grid is set.
+ * @return False if the grid is invalid.
+ */
+bool ApplyGridOptions(const RunOptions& options, MomentumDistributionCalculator& calculator);
+
+/**
+ * @brief Runs the deuteron command.
+ *
+ * Calculates the deuteron momentum distributions of the selected models in the
+ * JSON configuration, writes them to the data folder and plots them. In watch
+ * mode the configuration is then watched, and only models whose entries were
+ * added or changed are recalculated, written and plotted again.
+ *
+ * @param options Settings of the run.
+ * @return Exit code of the program.
+ */
+int RunDeuteron(const RunOptions& options);
+
+#endif // DEUTERON_COMMAND_H
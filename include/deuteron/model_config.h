@@ -0,0 +1,23 @@
+#ifndef DEUTERON_MODEL_CONFIG_H
+#define DEUTERON_MODEL_CONFIG_H
+
+#include <string>
+#include <vector>
+#include "json.hpp" // For handling JSON data.
+
+/**
+ * @brief Reads the model entries of a JSON configuration.
+ *
+ * Every entry needs a name, alpha, m_0 and numeric coefficient arrays c and d
+ * of equal length with at least three terms. Malformed files and entries are
+ * reported instead of aborting, so watch mode survives a half-saved
+ * configuration. This is the one loader of the deuteron command, the server,
+ * the C interface and the benchmarks.
+ *
+ * @param config_file Path of the model configuration.
+ * @param models Vector receiving the model entries; unchanged on failure.
+ * @return False if the file cannot be read or an entry is incomplete.
+ */
+bool LoadModels(const std::string& config_file, std::vector<nlohmann::json>& models);
+
+#endif // DEUTERON_MODEL_CONFIG_H
@@ -21,6 +21,28 @@ public:
      * @brief Default constructor for initializing the MomentumDistributionCalculator object.
      */
     MomentumDistributionCalculator();
+
+    /**
+     * @brief Sets the momentum grid of the calculated distributions.
+     * 
+     * The grid runs from zero to max_momentum in steps equal intervals 
+     * (steps + 1 points). The default is 400 intervals up to 0.4 GeV/c.
+     * 
+     * @param steps Number of grid intervals.
+     * @param max_momentum Upper end of the grid in GeV/c.
+     * @return True if the grid is valid, false otherwise (the grid is then unchanged).
+     */
+    bool SetGrid(int steps, double max_momentum);
+
+    /**
+     * @brief Returns the number of grid intervals.
+     */
+    int Steps() const { return steps; }
+
+    /**
+     * @brief Returns the upper end of the momentum grid in GeV/c.
+     */
+    double MaxMomentum() const { return max_momentum; }
     
     /**
      * @brief Calculates the momentum distribution for nucleons inside 
@@ -36,11 +58,64 @@ public:
         std::ofstream& out_file, double alpha, double m_0, 
         std::vector<double>& c, std::vector<double>& d);
 
+    /**
+     * @brief Calculates the momentum distribution for nucleons inside 
+     *        a deuteron and stores the results in memory.
+     * 
+     * @param alpha Alpha parameter defining the baseline mass scale for the potential model.
+     * @param m_0 Mass coefficient for the model.
+     * @param c Vector containing coefficients 'c' for the potential model calculation.
+     * @param d Vector containing coefficients 'd' for the potential model calculation.
+     * @param momentum Vector receiving the momentum grid in GeV/c.
+     * @param density Vector receiving the normalized momentum distribution.
+     */
+    void CalculateDistribution(
+        double alpha, double m_0, 
+        std::vector<double>& c, std::vector<double>& d,
+        std::vector<double>& momentum, std::vector<double>& density);
+
+    /**
+     * @brief Writes a calculated momentum distribution to a file in the format 
+     *        used by the file-based CalculateDistribution.
+     * 
+     * Momenta are written with three decimals, or with as many as needed to 
+     * resolve a finer grid.
+     * 
+     * @param out_file Reference to an ofstream object for writing the distribution data.
+     * @param momentum Momentum grid in GeV/c.
+     * @param density Momentum distribution at these momenta.
+     */
+    void WriteDistribution(
+        std::ofstream& out_file,
+        const std::vector<double>& momentum, const std::vector<double>& density);
+
+    /**
+     * @brief Calculates the reduced S- and D-wave functions u(r) and w(r) of 
+     *        the deuteron in coordinate space for the same parametrization.
+     * 
+     * The wave functions are the coordinate-space counterparts of the momentum-space 
+     * amplitudes used by CalculateDistribution and can be transformed into momentum 
+     * distributions with HankelTransform.
+     * 
+     * @param alpha Alpha parameter defining the baseline mass scale for the potential model.
+     * @param m_0 Mass coefficient for the model.
+     * @param c Vector containing coefficients 'c' for the potential model calculation.
+     * @param d Vector containing coefficients 'd' for the potential model calculation.
+     * @param radii Radii in fm at which to evaluate the wave functions.
+     * @param u Vector receiving the S-wave u(r).
+     * @param w Vector receiving the D-wave w(r).
+     */
+    void CalculateWaveFunctions(
+        double alpha, double m_0, 
+        std::vector<double>& c, std::vector<double>& d,
+        const std::vector<double>& radii,
+        std::vector<double>& u, std::vector<double>& w);
+
 private:
     const double sqrtpi2 = 0.7978845608;    // Pre-calculated sqrt(2/PI) for normalization.
     const double conversion = 0.19732697;   // Conversion factor from GeV/c to fm^-1 for momentum.
-    const int steps = 400;  // Number of steps for discretizing the momentum distribution
-    const double max_momentum = 0.4;    // Maximum momentum considered in GeV/c.
+    int steps = 400;    // Number of steps for discretizing the momentum distribution
+    double max_momentum = 0.4;  // Maximum momentum considered in GeV/c.
     
     /**
      * @brief Normalizes the coefficients 'c' and 'd' for the momentum distribution 
@@ -1,10 +1,29 @@
 #ifndef PLOT_GENERATOR_DEUTERON_H
 #define PLOT_GENERATOR_DEUTERON_H
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 #include <string>
 #include <utility>  // For std::pair
 #include "json.hpp" // For handling JSON data.
+#include "../common/curve_downsampler.h"
+#include "../common/cached_plot_backend.h"
+#include "../common/plot_backend.h"
+
+/**
+ * @struct DistributionView
+ * @brief Non-owning view of a momentum distribution held in memory.
+ *
+ * The columns are typically the vectors filled by 
+ * MomentumDistributionCalculator::CalculateDistribution and must outlive the view.
+ */
+struct DistributionView {
+    std::string model_name;     ///< Name of the potential model.
+    const double* momentum;     ///< Momentum column in GeV/c.
+    const double* density;      ///< Probability density column.
+    std::size_t size;           ///< Number of points in both columns.
+};
 
 /**
  * @class PlotGeneratorDeuteron
@@ -13,18 +32,53 @@
  *
  * This class is designed to generate graphical representations for the momentum 
  * distributions of nucleons inside a deuteron, based on various nucleon-nucleon 
- * potential models.
+ * potential models. The plots are described as PlotSpec objects and drawn by 
+ * the selected PlotBackend (ROOT or the built-in SVG/PNG renderer).
  */
 class PlotGeneratorDeuteron {
 public:
     /**
-     * Default constructor for initializing the PlotGeneratorDeuteron object.
+     * Constructor for initializing the PlotGeneratorDeuteron object.
+     *
+     * @param backend Backend drawing the plots; if null, the backend named by 
+     *        DefaultPlotBackendName() is created.
+     */
+    explicit PlotGeneratorDeuteron(std::unique_ptr<PlotBackend> backend = nullptr);
+
+    /**
+     * @brief Limits the number of points drawn per curve.
+     * 
+     * Denser curves are reduced with the LTTB downsampler before plotting, 
+     * keeping peaks and endpoints exact.
+     * 
+     * @param max_points Maximum number of points per curve; zero draws all points.
+     */
+    void SetMaxPlotPoints(std::size_t max_points) { downsampler.SetTargetPoints(max_points); }
+
+    /**
+     * @brief Redraws plots even if their images are up to date.
+     * 
+     * By default a plot is skipped when its image exists and was drawn from the 
+     * same data and style, as recorded in the "<image>.hash" sidecar file.
+     * 
+     * @param force If true, every plot is rendered.
      */
-    PlotGeneratorDeuteron();
+    void SetForceRender(bool force) { backend->SetForceRender(force); }
     
     /**
      * @brief Generates a plot for the momentum distribution of a single potential model.
      * 
+     * @param distribution View of the calculated momentum distribution.
+     * @param plot_file Path where the generated plot will be saved.
+     */
+    void GenerateSinglePlot(
+        const DistributionView& distribution, 
+        const std::string& plot_file);
+
+    /**
+     * @brief Generates a plot for the momentum distribution of a single potential 
+     *        model stored in a data file (for standalone use).
+     * 
      * @param model_name Name of the potential model being visualized.
      * @param data_file Path to the data file containing the momentum distribution.
      * @param plot_file Path where the generated plot will be saved.
@@ -34,9 +88,20 @@ public:
         const std::string& data_file, 
         const std::string& plot_file);
 
+    /**
+     * @brief Creates a combined plot for the momentum distributions of several models.
+     * 
+     * @param distributions Views of the calculated distributions, one per model.
+     * @param combined_plot_file Path where the combined plot will be saved.
+     */
+    void GenerateCombinedPlot(
+        const std::vector<DistributionView>& distributions, 
+        const std::string& combined_plot_file);
+
     /**
      * @brief Creates a combined plot for the momentum distributions derived 
-     *        from all specified models.
+     *        from all specified models, reading them from the data files 
+     *        (for standalone use).
      * 
      * @param models JSON object containing data for each model to be included in the plot.
      * @param combined_plot_file Path where the combined plot will be saved.
@@ -45,6 +110,64 @@ public:
         const nlohmann::json& models, 
         const std::string& combined_plot_file);
 
+    /**
+     * @brief Opens a multi-page document (PDF) collecting the following plot pages.
+     * 
+     * Writing all plots of a model catalog into one document opens and closes 
+     * a single file instead of one image file per model.
+     * 
+     * @param document_file Path of the document, e.g. "plots/deuteron_distributions.pdf".
+     * @return True if the document was opened.
+     */
+    bool BeginPlotDocument(const std::string& document_file);
+
+    /**
+     * @brief Adds the plot of a single potential model as a page of the open document.
+     * 
+     * @param distribution View of the calculated momentum distribution.
+     */
+    void AddSinglePlotPage(const DistributionView& distribution);
+
+    /**
+     * @brief Adds the combined plot of several models as a page of the open document.
+     * 
+     * @param distributions Views of the calculated distributions, one per model.
+     */
+    void AddCombinedPlotPage(const std::vector<DistributionView>& distributions);
+
+    /**
+     * @brief Completes and closes the open document.
+     * 
+     * @return True if the document was written completely.
+     */
+    bool EndPlotDocument();
+
+private:
+    std::unique_ptr<CachedPlotBackend> backend; // Renders the plot descriptions that changed
+    CurveDownsampler downsampler;               // Reduces dense curves before plotting
+
+    /**
+     * @brief Describes the plot of a single potential model.
+     */
+    PlotSpec SinglePlotSpec(const DistributionView& distribution);
+
+    /**
+     * @brief Describes the combined plot of several potential models.
+     */
+    PlotSpec CombinedPlotSpec(const std::vector<DistributionView>& distributions);
+
+    /**
+     * @brief Reads the momentum and density columns of a data file.
+     * 
+     * @param data_file Path to the data file containing the momentum distribution.
+     * @param momentum Vector receiving the momentum column.
+     * @param density Vector receiving the probability density column.
+     * @return True if the file could be opened, false otherwise.
+     */
+    bool ReadDataFile(
+        const std::string& data_file, 
+        std::vector<double>& momentum, 
+        std::vector<double>& density);
 };
 
 #endif // DEUTERON_PLOT_GENERATOR_H
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef HELIUM_COMMAND_H
+#define HELIUM_COMMAND_H
+
+#include "../common/run_options.h"
+
+/**
+ * @struct HeliumTable
+ * @brief 3He input table: file stem, momentum unit flag and normalisation flag.
+ */
+struct HeliumTable {
+    const char* name;
+    bool is_momentum_in_fm;
+    bool is_prob_normalized;
+};
+
+// Визначення, чи вимірювання імпульсів у fm^-1 і чи нормалізовані ймовірності
+inline constexpr HeliumTable HELIUM_TABLES[] = {
+    {"mom_distr_resonance_3he_e33", true, true},
+    {"mom_distr_resonance_3he_e53", false, false},
+    {"mom_distr_resonance_3he_e74", true, true},
+    {"mom_distr_nucleon_3he", true, true},
+    {"mom_distr_nucleon_3he_nogga", false, false},
+};
+
+/**
+ * @brief Runs the helium command.
+ *
+ * Converts and normalises the selected 3He momentum distributions from the
+ * input folder and plots them together. In watch mode the input tables are
+ * then watched, and only changed tables are converted again before replotting.
+ *
+ * @param options Settings of the run.
+ * @return Exit code of the program.
+ */
+int RunHelium(const RunOptions& options);
+
+#endif // HELIUM_COMMAND_H
@@ -1,8 +1,28 @@
 #ifndef HELIUM_MOMENTUM_DATA_LOADER_H
 #define HELIUM_MOMENTUM_DATA_LOADER_H
 
+#include <cstddef>
+#include <functional>
 #include <vector>
 #include <string>
+#include "../common/distribution_statistics.h"
+
+/**
+ * @struct MomentumDataChunk
+ * @brief Block of consecutive rows from a momentum distribution table.
+ *
+ * Momenta and probability densities are stored as separate columns so that
+ * per-chunk reductions run over contiguous arrays.
+ */
+struct MomentumDataChunk {
+    std::vector<float> momenta;         ///< Momentum column of the block.
+    std::vector<float> probabilities;   ///< Probability density column of the block.
+
+    /**
+     * @brief Returns the number of rows in the block.
+     */
+    std::size_t Size() const { return momenta.size(); }
+};
 
 /**
  * @class MomentumDataLoader
@@ -15,6 +35,14 @@
 
 class MomentumDataLoader {
 public:
+    /**
+     * @brief Callback receiving each block of a streamed table; returning false stops the stream.
+     */
+    using ChunkCallback = std::function<bool(const MomentumDataChunk&)>;
+
+    /// Default number of rows per streamed block.
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 4096;
+
     /**
      * @brief Constructor for a new MomentumDataLoader object
      * 
@@ -38,6 +66,26 @@ public:
         bool is_momentum_in_fm,
         bool is_prob_normalized);
 
+    /**
+     * @brief Processes data like LoadAndProcessData and additionally keeps the 
+     *        processed columns in memory, so they need not be read back from the 
+     *        output file.
+     * 
+     * @param input_file_path Path to the input file containing raw data.
+     * @param output_file_path Path where processed data should be saved.
+     * @param is_momentum_in_fm Flag indicating if the momentum values are in fm^-1.
+     * @param is_prob_normalized Flag indicating if the probability values are already normalized.
+     * @param momenta Vector receiving the processed momenta in GeV/c.
+     * @param probabilities Vector receiving the processed probability densities.
+     */
+    void LoadAndProcessData(
+        const std::string& input_file_path,
+        const std::string& output_file_path,
+        bool is_momentum_in_fm,
+        bool is_prob_normalized,
+        std::vector<float>& momenta,
+        std::vector<float>& probabilities);
+
     /**
      * @brief Loads data from a specified file path, parsing each line as 
      *        a pair of momentum and probability density values.
@@ -47,27 +95,154 @@ public:
      */
     std::vector<std::pair<float, float>> LoadData(const std::string& file_path);
 
-private:
     /**
-     * @brief Parses and processes a single line of input data, converting 
-     * momentum units from fm^-1 to GeV/c and normalizing probability densities.
+     * @brief Loads raw data into memory, converting momentum units and normalizing 
+     *        the probability densities in the same way as LoadAndProcessData.
      * 
-     * @param line A string representing a line of text from the data file.
+     * @param file_path The path to the text file containing the raw data.
      * @param is_momentum_in_fm Flag indicating if the momentum values are in fm^-1.
      * @param is_prob_normalized Flag indicating if the probability values are already normalized.
-     * @return A pair containing the momentum (in GeV/c) and its normalized probability density.
+     * @return A vector of <momentum (GeV/c), probability density> pairs.
      */
-    
-    std::pair<float, float> ParseAndProcessLine(
-        const std::string& line, bool is_momentum_in_fm, bool is_prob_normalized);
+    std::vector<std::pair<float, float>> LoadProcessedData(
+        const std::string& file_path,
+        bool is_momentum_in_fm,
+        bool is_prob_normalized);
+
+    /**
+     * @brief Streams a table in fixed-size blocks of rows without loading the whole file.
+     * 
+     * The same block buffers are reused for every call of the callback, so peak 
+     * memory does not depend on the file size.
+     * 
+     * @param file_path The path to the text file containing the data.
+     * @param callback Function called with each block; returning false stops reading.
+     * @param chunk_size Maximum number of rows per block.
+     * @return Number of rows passed to the callback.
+     */
+    std::size_t StreamData(
+        const std::string& file_path,
+        const ChunkCallback& callback,
+        std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief Streams a table in blocks, converting momentum units and normalizing 
+     *        probability densities in the same way as LoadAndProcessData.
+     * 
+     * @param file_path The path to the text file containing the raw data.
+     * @param is_momentum_in_fm Flag indicating if the momentum values are in fm^-1.
+     * @param is_prob_normalized Flag indicating if the probability values are already normalized.
+     * @param callback Function called with each processed block; returning false stops reading.
+     * @param chunk_size Maximum number of rows per block.
+     * @return Number of rows passed to the callback.
+     */
+    std::size_t StreamProcessedData(
+        const std::string& file_path,
+        bool is_momentum_in_fm,
+        bool is_prob_normalized,
+        const ChunkCallback& callback,
+        std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief Integrates the probability density over momentum (trapezoidal rule) 
+     *        as a streaming reduction.
+     * 
+     * @param file_path The path to the text file containing the data.
+     * @param chunk_size Maximum number of rows per block.
+     * @return The integral of the tabulated distribution, or zero if no rows
+     *         could be read.
+     */
+    double IntegrateData(
+        const std::string& file_path, 
+        std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief Rescales a table so that its integral over momentum equals one and 
+     *        saves it to an output file, streaming the input twice.
+     * 
+     * @param input_file_path Path to the input file containing the data.
+     * @param output_file_path Path where the normalized data should be saved.
+     * @param chunk_size Maximum number of rows per block.
+     * @return False if the table has no rows or a non-positive integral, or the
+     *         output file cannot be written.
+     */
+    bool NormalizeData(
+        const std::string& input_file_path,
+        const std::string& output_file_path,
+        std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief Returns validation counters and summary statistics of the most 
+     *        recently read table.
+     * 
+     * The statistics are collected while the table is parsed by any of the load 
+     * or stream functions and describe the rows as they were delivered 
+     * (after unit conversion and normalization, where applicable).
+     */
+    const DistributionStatistics& GetLastStatistics() const { return last_statistics; }
+
+private:
+    DistributionStatistics last_statistics; // Statistics of the most recently read table
+
 
     /**
      * @brief Parses a single line of text to extract momentum and probability density values.
      * 
-     * @param line A string representing a line of text from the data file.
-     * @return A pair representing momentum (GeV/c) and probability density. 
+     * @param begin Pointer to the first character of the line.
+     * @param end Pointer one past the last character of the line.
+     * @param momentum Receives the momentum value.
+     * @param probability Receives the probability density value.
+     * @return True if both values were parsed, false for a malformed line.
+     */
+    bool ParseLine(
+        const char* begin, const char* end, float& momentum, float& probability);
+
+    /**
+     * @brief Converts an input file and writes the processed rows to an output file, 
+     *        optionally appending them to in-memory columns as well.
+     * 
+     * @param input_file_path Path to the input file containing raw data.
+     * @param output_file_path Path where processed data should be saved.
+     * @param is_momentum_in_fm Flag indicating if the momentum values are in fm^-1.
+     * @param is_prob_normalized Flag indicating if the probability values are already normalized.
+     * @param momenta Vector receiving the processed momenta, or nullptr.
+     * @param probabilities Vector receiving the processed probability densities, or nullptr.
+     */
+    void ProcessToFile(
+        const std::string& input_file_path,
+        const std::string& output_file_path,
+        bool is_momentum_in_fm,
+        bool is_prob_normalized,
+        std::vector<float>* momenta,
+        std::vector<float>* probabilities);
+
+    /**
+     * @brief Reports problems found in the statistics of a table to standard error.
+     * 
+     * @param file_path The path of the table the statistics belong to.
+     */
+    void ReportStatistics(const std::string& file_path) const;
+
+    /**
+     * @brief Reads a file in fixed-size byte blocks, parses complete lines into 
+     *        row blocks, scales both columns and passes each row block to the callback.
+     * 
+     * Malformed lines are skipped and counted, blank lines are ignored, and the 
+     * statistics of every row block are accumulated before it is delivered.
+     * 
+     * @param file_path The path to the text file containing the data.
+     * @param momentum_factor Factor applied to every momentum value.
+     * @param probability_factor Factor applied to every probability density value.
+     * @param callback Function called with each block; returning false stops reading.
+     * @param chunk_size Maximum number of rows per block.
+     * @return Number of rows passed to the callback.
      */
-    std::pair<float, float> ParseLine(const std::string& line);
+    std::size_t StreamRows(
+        const std::string& file_path,
+        double momentum_factor,
+        double probability_factor,
+        const ChunkCallback& callback,
+        std::size_t chunk_size);
     
 };
 
@@ -0,0 +1,89 @@
+#ifndef HELIUM_MOMENTUM_FOLDING_H
+#define HELIUM_MOMENTUM_FOLDING_H
+
+#include <cstddef>
+#include <vector>
+#include "../common/fast_fourier_transform.h"
+
+/**
+ * @class MomentumFolding
+ * @brief Folds the N*-deuteron relative motion in ^3He with the nucleon motion
+ *        inside the deuteron to obtain single-nucleon momentum spectra.
+ *
+ * The ^3He nucleus is treated as a bound N*-deuteron system. A nucleon of the
+ * deuteron carries the momentum k - (m_N / m_d) q, where q is the N*-d relative
+ * momentum and k the nucleon momentum inside the deuteron. For isotropic
+ * distributions the three-dimensional convolution becomes a product of their
+ * Fourier transforms, which are sine transforms of rho(k)/k on a uniform radial
+ * grid. All transforms run through an FFT, and the deuteron transform is cached,
+ * so a folded table for a new binding energy costs two O(N log N) transforms.
+ *
+ * All distributions are radial probability densities rho(k), normalized here
+ * so that the integral of rho(k) dk equals one.
+ */
+class MomentumFolding {
+public:
+    /**
+     * @brief Constructor for a new MomentumFolding object.
+     *
+     * @param max_momentum Upper end of the radial momentum grid in GeV/c; it must
+     *        exceed the range of both distributions combined.
+     * @param points Number of grid points; rounded up to the next power of two.
+     * @param recoil_fraction Fraction of the relative momentum carried by the
+     *        nucleon (m_N / m_d, i.e. one half).
+     */
+    explicit MomentumFolding(
+        double max_momentum = 2.0, std::size_t points = 2048,
+        double recoil_fraction = 0.5);
+
+    /**
+     * @brief Sets the nucleon momentum distribution inside the deuteron and caches its transform.
+     *
+     * @param momenta Ascending momenta in GeV/c (e.g. from MomentumDistributionCalculator).
+     * @param densities Momentum distribution at these momenta (any normalization).
+     * @return True on success, false if the distribution has no positive integral.
+     */
+    bool SetDeuteronDistribution(
+        const std::vector<double>& momenta, const std::vector<double>& densities);
+
+    /**
+     * @brief Folds an N*-d relative momentum distribution with the cached deuteron distribution.
+     *
+     * @param momenta Ascending relative momenta in GeV/c.
+     * @param densities Relative momentum distribution at these momenta (any normalization).
+     * @param nucleon_density Vector receiving the nucleon momentum distribution on Grid().
+     * @return True on success, false if no deuteron distribution is set or the
+     *         input has no positive integral.
+     */
+    bool Fold(
+        const std::vector<double>& momenta, const std::vector<double>& densities,
+        std::vector<double>& nucleon_density) const;
+
+    /**
+     * @brief Returns the radial momentum grid of the folded distribution.
+     */
+    const std::vector<double>& Grid() const { return grid; }
+
+private:
+    std::vector<double> grid;               // Uniform radial momentum grid, grid[0] = 0
+    double step;                            // Grid spacing
+    double recoil_fraction;                 // Scale from relative to nucleon momentum
+    SineTransform sine_transform;           // Cached FFT-based sine transform
+    std::vector<double> deuteron_transform; // Sine transform of the deuteron rho(k)/k
+
+    /**
+     * @brief Resamples a distribution onto the grid, normalizes it and returns
+     *        the sine transform of rho(k)/k.
+     *
+     * @param momenta Ascending momenta of the input table.
+     * @param densities Distribution at these momenta.
+     * @param scale Factor mapping grid momenta to table momenta (table p = grid k / scale).
+     * @param transform Vector receiving the sine transform.
+     * @return True if the distribution has a positive integral.
+     */
+    bool TransformDistribution(
+        const std::vector<double>& momenta, const std::vector<double>& densities,
+        double scale, std::vector<double>& transform) const;
+};
+
+#endif // HELIUM_MOMENTUM_FOLDING_H
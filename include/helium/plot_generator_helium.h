@@ -1,23 +1,53 @@
 #ifndef PLOT_GENERATOR_HELIUM_H
 #define PLOT_GENERATOR_HELIUM_H
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <utility> // For std::pair
+#include "../common/curve_downsampler.h"
+#include "../common/cached_plot_backend.h"
+#include "../common/plot_backend.h"
 
 /**
  * @class PlotGeneratorHelium
  * @brief Generates plots for visualizing the momentum distribution 
  *        of N* resonance within a ^3He nucleus.
+ *
+ * The plots are drawn by the selected PlotBackend (ROOT or the built-in 
+ * SVG/PNG renderer).
  */
 class PlotGeneratorHelium {
 public:
     /**
-     * @brief Default constructor for PlotGeneratorHelium.
+     * @brief Constructor for PlotGeneratorHelium.
      * 
      * Initializes a new instance of the PlotGeneratorHelium class.
+     *
+     * @param backend Backend drawing the plots; if null, the backend named by 
+     *        DefaultPlotBackendName() is created.
+     */
+    explicit PlotGeneratorHelium(std::unique_ptr<PlotBackend> backend = nullptr);
+
+    /**
+     * @brief Limits the number of points drawn per curve.
+     * 
+     * Denser curves are reduced with the LTTB downsampler before plotting, 
+     * keeping peaks and endpoints exact.
+     * 
+     * @param max_points Maximum number of points per curve; zero draws all points.
      */
-    PlotGeneratorHelium() = default;
+    void SetMaxPlotPoints(std::size_t max_points) { downsampler.SetTargetPoints(max_points); }
+
+    /**
+     * @brief Redraws plots even if their images are up to date.
+     * 
+     * By default a plot is skipped when its image exists and was drawn from the 
+     * same data and style, as recorded in the "<image>.hash" sidecar file.
+     * 
+     * @param force If true, every plot is rendered.
+     */
+    void SetForceRender(bool force) { backend->SetForceRender(force); }
 
     /**
      * @brief Generates a plot combining multiple datasets.
@@ -35,6 +65,9 @@ public:
         const std::string& output_file_path);
 
 private:
+    std::unique_ptr<CachedPlotBackend> backend; // Renders the plot descriptions that changed
+    CurveDownsampler downsampler;               // Reduces dense curves before plotting
+
     /**
      * @brief Customizes the appearance of the plot.
      * 
@@ -0,0 +1,129 @@
+#ifndef HELIUM_RESONANCE_ENERGY_MODEL_H
+#define HELIUM_RESONANCE_ENERGY_MODEL_H
+
+#include <cstddef>
+#include <vector>
+#include <string>
+#include "../common/momentum_interpolator.h"
+
+/**
+ * @struct ResonanceTable
+ * @brief Describes an input table of the N* momentum distribution for one binding energy.
+ */
+struct ResonanceTable {
+    double binding_energy;      ///< Binding energy E_{N*-d} in MeV (e.g. -0.33).
+    std::string file_path;      ///< Path to the raw input table.
+    bool is_momentum_in_fm;     ///< True if the momenta are given in fm^-1.
+    bool is_prob_normalized;    ///< True if the probability densities are already normalized.
+};
+
+/**
+ * @class ResonanceEnergyModel
+ * @brief Interpolates the N* momentum distribution in ^3He between the binding
+ *        energies for which it was calculated.
+ *
+ * The input tables are loaded and converted once, resampled onto a common
+ * momentum grid and turned into a cached two-dimensional (energy, momentum)
+ * interpolant: for every grid momentum the energy dependence is stored as
+ * piecewise cubic coefficients. A distribution at any energy inside the
+ * tabulated range then costs one segment lookup and one Horner evaluation per
+ * grid point.
+ */
+class ResonanceEnergyModel {
+public:
+    /// Number of grid points used when no momentum grid is given.
+    static constexpr std::size_t DEFAULT_GRID_POINTS = 400;
+
+    /**
+     * @brief Constructor for a new ResonanceEnergyModel object.
+     *
+     * @param momentum_grid Ascending momentum grid in GeV/c; if empty, an
+     *        equidistant grid over the momentum range shared by all tables is used.
+     * @param energy_method Interpolation scheme along the binding energy.
+     * @param momentum_method Interpolation scheme used to resample the tables.
+     */
+    explicit ResonanceEnergyModel(
+        std::vector<double> momentum_grid = {},
+        InterpolationMethod energy_method = InterpolationMethod::kCubicSpline,
+        InterpolationMethod momentum_method = InterpolationMethod::kPchip);
+
+    /**
+     * @brief Loads the tables and builds the cached interpolant.
+     *
+     * @param tables Input tables, at least two distinct binding energies.
+     * @return True on success, false if a table could not be loaded.
+     */
+    bool LoadTables(const std::vector<ResonanceTable>& tables);
+
+    /**
+     * @brief Computes the distribution on the momentum grid for one binding energy.
+     *
+     * @param energy Binding energy in MeV, inside [MinEnergy(), MaxEnergy()].
+     * @param density Vector receiving Grid().size() probability densities.
+     * @return True on success, false if the energy lies outside the tabulated range.
+     */
+    bool DistributionAt(double energy, std::vector<double>& density) const;
+
+    /**
+     * @brief Computes the distributions for a batch of binding energies.
+     *
+     * Energies outside the tabulated range yield rows of zeros.
+     *
+     * @param binding_energies Binding energies in MeV.
+     * @param densities Vector receiving binding_energies.size() rows of Grid().size()
+     *        densities each, stored row after row.
+     * @return Number of energies inside the tabulated range.
+     */
+    std::size_t DistributionsAt(
+        const std::vector<double>& binding_energies,
+        std::vector<double>& densities) const;
+
+    /**
+     * @brief Evaluates the distribution at a single (energy, momentum) point.
+     *
+     * @param energy Binding energy in MeV.
+     * @param momentum Momentum in GeV/c.
+     * @return Interpolated probability density, or zero outside the tabulated ranges.
+     */
+    double Evaluate(double energy, double momentum) const;
+
+    /**
+     * @brief Returns the momentum grid of the cached interpolant.
+     */
+    const std::vector<double>& Grid() const { return grid; }
+
+    /**
+     * @brief Returns the lowest tabulated binding energy.
+     */
+    double MinEnergy() const { return energies.empty() ? 0. : energies.front(); }
+
+    /**
+     * @brief Returns the highest tabulated binding energy.
+     */
+    double MaxEnergy() const { return energies.empty() ? 0. : energies.back(); }
+
+private:
+    std::vector<double> grid;           // Momentum grid in GeV/c
+    InterpolationMethod energy_method;  // Scheme along the binding energy
+    InterpolationMethod momentum_method; // Scheme used to resample the tables
+    std::vector<double> energies;       // Ascending tabulated binding energies
+    std::vector<double> coefficients;   // [segment][a, b, c, d][grid point]
+
+    /**
+     * @brief Writes the distribution for an in-range energy to an output buffer.
+     *
+     * @param energy Binding energy in MeV.
+     * @param density Pointer to Grid().size() output densities.
+     */
+    void Fill(double energy, double* density) const;
+
+    /**
+     * @brief Finds the energy segment containing the given energy.
+     *
+     * @param energy Binding energy inside the tabulated range.
+     * @return Segment index in [0, energies.size() - 2].
+     */
+    std::size_t FindSegment(double energy) const;
+};
+
+#endif // HELIUM_RESONANCE_ENERGY_MODEL_H
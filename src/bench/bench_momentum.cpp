@@ -0,0 +1,487 @@
+/**
+ * @file bench_momentum.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Microbenchmarks of the deuteron kernel, table parsing, configuration
+ *        loading, sampling, file output and plot rendering.
+ *
+ * @details
+ * The benchmarks use Google Benchmark and are parameterised by problem size:
+ *  - Kernel: MomentumDistributionCalculator::CalculateDistribution against the
+ *    number of grid steps and the number of Yukawa terms (the first terms of
+ *    the Paris parametrisation).
+ *  - Parsing: the MomentumDataLoader read paths on synthetic 3He tables as
+ *    large as all files in the input directory together, and 1000 times
+ *    larger; throughput is reported in bytes per second.
+ *  - Configuration: parsing and validating model configurations of 2 to 1024
+ *    models.
+ *  - Sampling: building a MomentumSampler and drawing batches of momenta.
+ *  - Output: text and binary distribution files against the grid size.
+ *  - Plotting: single and combined plots with the backend chosen by
+ *    PLOT_BACKEND, rendered every time, and a single plot that is up to date.
+ *
+ * Run from the repository root:
+ *     ./bench_momentum [--config <file>] [--input-dir <dir>] [benchmark options]
+ * The results are written as JSON to the standard output unless
+ * --benchmark_format selects another format. The options of Google Benchmark
+ * apply, e.g. --benchmark_filter=Table or --benchmark_out=results.json.
+ * Scratch files are written to a directory under TMPDIR (or /tmp) that is
+ * removed at the end. Build with -DCMAKE_BUILD_TYPE=Release for meaningful
+ * numbers.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/common/distribution_file.h"
+#include "../include/common/momentum_sampler.h"
+#include "../include/common/plot_backend.h"
+#include "../include/deuteron/model_config.h"
+#include "../include/deuteron/momentum_distribution.h"
+#include "../include/deuteron/plot_generator_deuteron.h"
+#include "../include/helium/momentum_data_loader.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+/**
+ * Parameters of a deuteron model taken from the configuration.
+ */
+struct ModelParameters {
+    std::string name;
+    double alpha = 0.;
+    double m_0 = 0.;
+    std::vector<double> c;
+    std::vector<double> d;
+};
+
+/**
+ * Settings shared by the benchmarks, filled in main() before they run.
+ */
+struct BenchSettings {
+    std::string config_file = "src/deuteron/models_config.json";
+    std::string input_dir = "input";
+    std::string work_dir;               // Scratch directory of this run
+    std::uint64_t input_bytes = 0;      // Size of all tables in the input directory
+    std::vector<ModelParameters> models;
+};
+
+static BenchSettings settings;
+
+/**
+ * Size of a file in bytes, or zero if it does not exist.
+ */
+static std::uint64_t FileSize(const std::string& path)
+{
+    struct stat status;
+    return stat(path.c_str(), &status) == 0 ? std::uint64_t(status.st_size) : 0;
+}
+
+/**
+ * Total size of the .txt tables in a directory.
+ */
+static std::uint64_t DirectoryTableBytes(const std::string& directory)
+{
+    std::uint64_t total = 0;
+    DIR* handle = opendir(directory.c_str());
+    if (handle == nullptr) {
+        return 0;
+    }
+    while (dirent* entry = readdir(handle)) {
+        std::string name = entry->d_name;
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".txt") == 0) {
+            total += FileSize(directory + "/" + name);
+        }
+    }
+    closedir(handle);
+    return total;
+}
+
+/**
+ * Removes the scratch directory and the files in it.
+ */
+static void RemoveWorkDirectory(const std::string& directory)
+{
+    DIR* handle = opendir(directory.c_str());
+    if (handle == nullptr) {
+        return;
+    }
+    while (dirent* entry = readdir(handle)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") {
+            unlink((directory + "/" + name).c_str());
+        }
+    }
+    closedir(handle);
+    rmdir(directory.c_str());
+}
+
+/**
+ * Reads the deuteron models of the configuration with the loader of the
+ * deuteron command.
+ */
+static bool LoadModelParameters(const std::string& config_file, std::vector<ModelParameters>& models)
+{
+    std::vector<json> entries;
+    if (!LoadModels(config_file, entries)) {
+        return false;
+    }
+    if (entries.empty()) {
+        std::cerr << "Error: " << config_file << " holds no models." << std::endl;
+        return false;
+    }
+    for (const json& model : entries) {
+        models.push_back({model["name"], model["alpha"], model["m_0"],
+                          model["parameters"]["c"], model["parameters"]["d"]});
+    }
+    return true;
+}
+
+/**
+ * Distribution of the first model on a grid of the given number of steps.
+ */
+static void ReferenceDistribution(int steps, std::vector<double>& momenta, std::vector<double>& densities)
+{
+    const ModelParameters& model = settings.models.front();
+    std::vector<double> c = model.c;
+    std::vector<double> d = model.d;
+    MomentumDistributionCalculator calculator;
+    calculator.SetGrid(steps, 0.4);
+    calculator.CalculateDistribution(model.alpha, model.m_0, c, d, momenta, densities);
+}
+
+/**
+ * Path of a synthetic 3He table of scale times the size of the input
+ * directory, written on first use. The rows follow the format of the input
+ * tables: momentum in fm^-1 and an unnormalised density.
+ */
+static const std::string& SyntheticTable(std::int64_t scale)
+{
+    static std::map<std::int64_t, std::string> tables;
+    auto found = tables.find(scale);
+    if (found != tables.end()) {
+        return found->second;
+    }
+
+    std::string path = settings.work_dir + "/table_x" + std::to_string(scale) + ".txt";
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    const std::uint64_t target = std::uint64_t(scale) * settings.input_bytes;
+    const std::uint64_t rows = target / 26 + 2;  // A row holds about 26 characters
+    const double step = 15. / double(rows);      // Momenta up to 15 fm^-1
+    std::uint64_t written = 0;
+    for (std::uint64_t i = 0; file != nullptr && written < target; ++i) {
+        double momentum = (double(i) + 0.5) * step;
+        double density = momentum * momentum * std::exp(-momentum * momentum);
+        int length = std::fprintf(file, "%.9g %.6g\n", momentum, density);
+        written += length > 0 ? std::uint64_t(length) : 0;
+    }
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+    return tables[scale] = path;
+}
+
+/**
+ * Writes a configuration with the given number of models, cycling through
+ * the models of the real configuration, and returns its path.
+ */
+static const std::string& SyntheticConfig(std::int64_t model_count)
+{
+    static std::map<std::int64_t, std::string> configs;
+    auto found = configs.find(model_count);
+    if (found != configs.end()) {
+        return found->second;
+    }
+
+    json config;
+    config["models"] = json::array();
+    for (std::int64_t i = 0; i < model_count; ++i) {
+        const ModelParameters& model = settings.models[std::size_t(i) % settings.models.size()];
+        config["models"].push_back({
+            {"name", model.name + "_" + std::to_string(i)},
+            {"alpha", model.alpha},
+            {"m_0", model.m_0},
+            {"parameters", {{"c", model.c}, {"d", model.d}}},
+        });
+    }
+    std::string path = settings.work_dir + "/models_x" + std::to_string(model_count) + ".json";
+    std::ofstream(path) << config.dump(4);
+    return configs[model_count] = path;
+}
+
+/**
+ * Plot generator shared by the plotting benchmarks, so that the backend
+ * (and a missing ROOT plugin) is set up once.
+ */
+static PlotGeneratorDeuteron& PlotGenerator()
+{
+    static PlotGeneratorDeuteron generator(CreatePlotBackend(DefaultPlotBackendName()));
+    return generator;
+}
+
+static void BM_CalculateDistribution(benchmark::State& state)
+{
+    const int steps = int(state.range(0));
+    const std::size_t terms = std::size_t(state.range(1));
+    const ModelParameters& model = settings.models.front();
+    if (terms < 3 || terms > model.c.size()) {
+        state.SkipWithError("Term count outside the range of the model");
+        return;
+    }
+
+    // The first terms of the model; the last ones are fixed by the normalisation
+    std::vector<double> c(model.c.begin(), model.c.begin() + terms);
+    std::vector<double> d(model.d.begin(), model.d.begin() + terms);
+    c[terms - 1] = 0.;
+    for (std::size_t i = terms - 3; i < terms; ++i) {d[i] = 0.;}
+
+    MomentumDistributionCalculator calculator;
+    calculator.SetGrid(steps, 0.4);
+    std::vector<double> momenta, densities;
+    for (auto _ : state) {
+        std::vector<double> c_terms = c;  // Normalised in place by the calculator
+        std::vector<double> d_terms = d;
+        calculator.CalculateDistribution(model.alpha, model.m_0, c_terms, d_terms, momenta, densities);
+        benchmark::DoNotOptimize(densities.data());
+    }
+    state.SetItemsProcessed(state.iterations() * (steps + 1));
+}
+BENCHMARK(BM_CalculateDistribution)
+    ->ArgsProduct({{100, 400, 1600, 6400}, {4, 8, 13}})
+    ->ArgNames({"steps", "terms"});
+
+static void BM_StreamTable(benchmark::State& state)
+{
+    const std::string& path = SyntheticTable(state.range(0));
+    MomentumDataLoader loader;
+    for (auto _ : state) {
+        std::size_t rows = loader.StreamData(path, [](const MomentumDataChunk& chunk) {
+            benchmark::DoNotOptimize(chunk.momenta.data());
+            return true;
+        });
+        benchmark::DoNotOptimize(rows);
+    }
+    state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(FileSize(path)));
+}
+BENCHMARK(BM_StreamTable)->Arg(1)->Arg(1000)->ArgName("scale")->Unit(benchmark::kMillisecond);
+
+static void BM_StreamProcessedTable(benchmark::State& state)
+{
+    const std::string& path = SyntheticTable(state.range(0));
+    MomentumDataLoader loader;
+    for (auto _ : state) {
+        std::size_t rows = loader.StreamProcessedData(path, true, true, [](const MomentumDataChunk& chunk) {
+            benchmark::DoNotOptimize(chunk.probabilities.data());
+            return true;
+        });
+        benchmark::DoNotOptimize(rows);
+    }
+    state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(FileSize(path)));
+}
+BENCHMARK(BM_StreamProcessedTable)->Arg(1)->Arg(1000)->ArgName("scale")->Unit(benchmark::kMillisecond);
+
+static void BM_LoadTable(benchmark::State& state)
+{
+    const std::string& path = SyntheticTable(state.range(0));
+    MomentumDataLoader loader;
+    for (auto _ : state) {
+        std::vector<std::pair<float, float>> data = loader.LoadData(path);
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(FileSize(path)));
+}
+BENCHMARK(BM_LoadTable)->Arg(1)->Arg(1000)->ArgName("scale")->Unit(benchmark::kMillisecond);
+
+static void BM_LoadConfig(benchmark::State& state)
+{
+    const std::string& path = SyntheticConfig(state.range(0));
+    for (auto _ : state) {
+        std::vector<ModelParameters> models;
+        if (!LoadModelParameters(path, models)) {
+            state.SkipWithError("Configuration could not be loaded");
+            break;
+        }
+        benchmark::DoNotOptimize(models.data());
+    }
+    state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(FileSize(path)));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoadConfig)->Arg(2)->Arg(64)->Arg(1024)->ArgName("models");
+
+static void BM_BuildSampler(benchmark::State& state)
+{
+    std::vector<double> momenta, densities;
+    ReferenceDistribution(int(state.range(0)), momenta, densities);
+    MomentumSampler sampler;
+    for (auto _ : state) {
+        sampler.Build(momenta.data(), densities.data(), momenta.size());
+        benchmark::DoNotOptimize(sampler.Norm());
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t(momenta.size()));
+}
+BENCHMARK(BM_BuildSampler)->Arg(400)->Arg(6400)->Arg(102400)->ArgName("steps");
+
+static void BM_SampleMomenta(benchmark::State& state)
+{
+    std::vector<double> momenta, densities;
+    ReferenceDistribution(400, momenta, densities);
+    MomentumSampler sampler(momenta, densities);
+    std::mt19937_64 engine(1);
+    std::vector<double> sample(std::size_t(state.range(0)));
+    for (auto _ : state) {
+        sampler.Sample(engine, sample.data(), sample.size());
+        benchmark::DoNotOptimize(sample.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SampleMomenta)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20)->ArgName("count");
+
+static void BM_WriteTextTable(benchmark::State& state)
+{
+    std::vector<double> momenta, densities;
+    ReferenceDistribution(int(state.range(0)), momenta, densities);
+    std::string path = settings.work_dir + "/distribution.txt";
+    MomentumDistributionCalculator calculator;
+
+    // WriteDistribution reports every file on the standard output, which carries the results
+    std::streambuf* output = std::cout.rdbuf(nullptr);
+    for (auto _ : state) {
+        std::ofstream out_file(path);
+        calculator.WriteDistribution(out_file, momenta, densities);
+    }
+    std::cout.rdbuf(output);
+    std::cout.clear();
+    state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(FileSize(path)));
+}
+BENCHMARK(BM_WriteTextTable)->Arg(400)->Arg(6400)->Arg(102400)->ArgName("steps");
+
+static void BM_WriteBinaryTable(benchmark::State& state)
+{
+    std::vector<double> momenta, densities;
+    ReferenceDistribution(int(state.range(0)), momenta, densities);
+    std::string path = settings.work_dir + "/distribution.bin";
+    for (auto _ : state) {
+        DistributionFile::WriteBinary(path, momenta.data(), densities.data(), momenta.size());
+    }
+    state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(FileSize(path)));
+}
+BENCHMARK(BM_WriteBinaryTable)->Arg(400)->Arg(6400)->Arg(102400)->ArgName("steps");
+
+static void BM_RenderSinglePlot(benchmark::State& state, const char* extension, bool force)
+{
+    std::vector<double> momenta, densities;
+    ReferenceDistribution(int(state.range(0)), momenta, densities);
+    DistributionView view = {settings.models.front().name, momenta.data(), densities.data(), momenta.size()};
+    std::string path = settings.work_dir + "/single_plot" + extension;
+
+    PlotGeneratorDeuteron& generator = PlotGenerator();
+    generator.SetForceRender(force);
+    generator.GenerateSinglePlot(view, path);  // Loads a plugin backend before timing
+    for (auto _ : state) {
+        generator.GenerateSinglePlot(view, path);
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t(momenta.size()));
+}
+BENCHMARK_CAPTURE(BM_RenderSinglePlot, png, ".png", true)
+    ->Arg(400)->Arg(6400)->ArgName("steps")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RenderSinglePlot, svg, ".svg", true)
+    ->Arg(400)->Arg(6400)->ArgName("steps")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RenderSinglePlot, pdf, ".pdf", true)
+    ->Arg(400)->Arg(6400)->ArgName("steps")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RenderSinglePlot, png_up_to_date, ".png", false)
+    ->Arg(400)->Arg(6400)->ArgName("steps");
+
+static void BM_RenderCombinedPlot(benchmark::State& state)
+{
+    const int steps = int(state.range(0));
+    std::vector<std::vector<double>> momenta(settings.models.size()), densities(settings.models.size());
+    std::vector<DistributionView> views;
+    MomentumDistributionCalculator calculator;
+    calculator.SetGrid(steps, 0.4);
+    for (std::size_t i = 0; i < settings.models.size(); ++i) {
+        ModelParameters model = settings.models[i];
+        calculator.CalculateDistribution(model.alpha, model.m_0, model.c, model.d, momenta[i], densities[i]);
+        views.push_back({model.name, momenta[i].data(), densities[i].data(), momenta[i].size()});
+    }
+    std::string path = settings.work_dir + "/combined_plot.png";
+
+    PlotGeneratorDeuteron& generator = PlotGenerator();
+    generator.SetForceRender(true);
+    generator.GenerateCombinedPlot(views, path);
+    for (auto _ : state) {
+        generator.GenerateCombinedPlot(views, path);
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t(views.size()) * (steps + 1));
+}
+BENCHMARK(BM_RenderCombinedPlot)->Arg(400)->Arg(6400)->ArgName("steps")->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv)
+{
+    // JSON on the standard output unless another format is requested
+    std::vector<char*> arguments(argv, argv + argc);
+    bool has_format = false;
+    for (int i = 1; i < argc; ++i) {
+        has_format = has_format || std::strncmp(argv[i], "--benchmark_format", 18) == 0;
+    }
+    char json_format[] = "--benchmark_format=json";
+    if (!has_format) {
+        arguments.insert(arguments.begin() + 1, json_format);
+    }
+    int argument_count = int(arguments.size());
+    benchmark::Initialize(&argument_count, arguments.data());
+
+    for (int i = 1; i < argument_count; ++i) {
+        std::string option = arguments[i];
+        if ((option == "--config" || option == "--input-dir") && i + 1 < argument_count) {
+            (option == "--config" ? settings.config_file : settings.input_dir) = arguments[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--config <file>] [--input-dir <dir>] [benchmark options]\n"
+                      << "Unknown option: " << option << std::endl;
+            return 1;
+        }
+    }
+    if (!LoadModelParameters(settings.config_file, settings.models)) {
+        return 1;
+    }
+    settings.input_bytes = DirectoryTableBytes(settings.input_dir);
+    if (settings.input_bytes == 0) {
+        std::cerr << "Error: No input tables found in " << settings.input_dir << "." << std::endl;
+        return 1;
+    }
+
+    const char* temporary = std::getenv("TMPDIR");
+    std::string pattern = std::string(temporary != nullptr ? temporary : "/tmp") + "/bench_momentum.XXXXXX";
+    if (mkdtemp(&pattern[0]) == nullptr) {
+        std::cerr << "Error: Could not create a scratch directory." << std::endl;
+        return 1;
+    }
+    settings.work_dir = pattern;
+
+    benchmark::AddCustomContext("config_file", settings.config_file);
+    benchmark::AddCustomContext("input_bytes", std::to_string(settings.input_bytes));
+    benchmark::AddCustomContext("plot_backend", DefaultPlotBackendName());
+#ifdef __OPTIMIZE__
+    benchmark::AddCustomContext("optimized", "true");
+#else
+    benchmark::AddCustomContext("optimized", "false");
+#endif
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    RemoveWorkDirectory(settings.work_dir);
+    return 0;
+}
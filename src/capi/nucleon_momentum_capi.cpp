@@ -0,0 +1,267 @@
+/**
+ * @file nucleon_momentum_capi.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the C interface declared in capi/nucleon_momentum.h.
+ *
+ * @details
+ * A model wraps a MomentumSampler together with the columns it was built
+ * from. No C++ exception may cross into a C or Fortran caller, so the
+ * constructors, the only functions that allocate, catch everything and
+ * return NULL. The random numbers come from xoshiro256** seeded through
+ * splitmix64 rather than from the standard library, whose distributions
+ * differ between implementations; a uniform takes the top 53 bits of a draw.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/capi/nucleon_momentum.h"
+#include "../include/common/distribution_file.h"
+#include "../include/common/momentum_sampler.h"
+#include "../include/deuteron/model_config.h"
+#include "../include/deuteron/momentum_distribution.h"
+#include "../include/helium/momentum_data_loader.h"
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using json = nlohmann::json;
+
+struct nm_model {
+    std::vector<double> momenta;    // Tabulated momenta
+    std::vector<double> densities;  // Tabulated densities as loaded
+    MomentumSampler sampler;        // Sampler built from the columns
+};
+
+/**
+ * Creates a model from its columns, or returns NULL if they cannot be sampled.
+ */
+static nm_model* NewModel(std::vector<double>&& momenta, std::vector<double>&& densities)
+{
+    nm_model* model = new nm_model;
+    model->momenta = std::move(momenta);
+    model->densities = std::move(densities);
+    if (!model->sampler.Build(model->momenta.data(), model->densities.data(), model->momenta.size())) {
+        delete model;
+        return nullptr;
+    }
+    return model;
+}
+
+static std::uint64_t SplitMix64(std::uint64_t& x)
+{
+    std::uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+static inline std::uint64_t RotateLeft(std::uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline double NextUniform(std::uint64_t* s)
+{
+    std::uint64_t result = RotateLeft(s[1] * 5, 7) * 9;
+    std::uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = RotateLeft(s[3], 45);
+    return double(result >> 11) * 0x1.0p-53;
+}
+
+extern "C" {
+
+int nm_api_version(void)
+{
+    return NM_API_VERSION;
+}
+
+nm_model* nm_model_from_json(
+    const char* config_path, const char* model_name, int steps, double max_momentum)
+{
+    if (config_path == nullptr || model_name == nullptr) {
+        return nullptr;
+    }
+    try {
+        std::vector<json> models;
+        if (!LoadModels(config_path, models)) {
+            return nullptr;
+        }
+        for (const json& model : models) {
+            if (model["name"] != model_name) {continue;}
+            MomentumDistributionCalculator calculator;
+            if (!calculator.SetGrid(steps, max_momentum)) {
+                return nullptr;
+            }
+            std::vector<double> c = model["parameters"]["c"];
+            std::vector<double> d = model["parameters"]["d"];
+            std::vector<double> momenta, densities;
+            calculator.CalculateDistribution(model["alpha"], model["m_0"], c, d, momenta, densities);
+            return NewModel(std::move(momenta), std::move(densities));
+        }
+        std::cerr << "Error: No model " << model_name << " in " << config_path << "." << std::endl;
+    } catch (const std::exception& error) {
+        std::cerr << "Error: " << error.what() << std::endl;
+    }
+    return nullptr;
+}
+
+nm_model* nm_model_from_table(const char* path, int momentum_in_fm, int normalize)
+{
+    if (path == nullptr) {
+        return nullptr;
+    }
+    try {
+        char magic[sizeof(DistributionFile::MAGIC)] = {};
+        std::ifstream probe(path, std::ios::binary);
+        if (!probe.is_open()) {
+            std::cerr << "Error: Could not open the data file: " << path << std::endl;
+            return nullptr;
+        }
+        probe.read(magic, sizeof(magic));
+        probe.close();
+
+        std::vector<double> momenta, densities;
+        if (std::memcmp(magic, DistributionFile::MAGIC, sizeof(magic)) == 0) {
+            if (!DistributionFile::ReadBinary(path, momenta, densities)) {
+                return nullptr;
+            }
+        } else {
+            MomentumDataLoader loader;
+            loader.StreamProcessedData(path, momentum_in_fm != 0, normalize != 0,
+                [&momenta, &densities](const MomentumDataChunk& chunk) {
+                    momenta.insert(momenta.end(), chunk.momenta.begin(), chunk.momenta.end());
+                    densities.insert(densities.end(), chunk.probabilities.begin(), chunk.probabilities.end());
+                    return true;
+                });
+        }
+        return NewModel(std::move(momenta), std::move(densities));
+    } catch (const std::exception& error) {
+        std::cerr << "Error: " << error.what() << std::endl;
+    }
+    return nullptr;
+}
+
+nm_model* nm_model_from_arrays(const double* momenta, const double* densities, size_t count)
+{
+    if (momenta == nullptr || densities == nullptr) {
+        return nullptr;
+    }
+    try {
+        return NewModel(std::vector<double>(momenta, momenta + count),
+                        std::vector<double>(densities, densities + count));
+    } catch (const std::exception& error) {
+        std::cerr << "Error: " << error.what() << std::endl;
+    }
+    return nullptr;
+}
+
+void nm_model_destroy(nm_model* model)
+{
+    delete model;
+}
+
+size_t nm_model_size(const nm_model* model)
+{
+    return model != nullptr ? model->momenta.size() : 0;
+}
+
+const double* nm_model_momenta(const nm_model* model)
+{
+    return model != nullptr ? model->momenta.data() : nullptr;
+}
+
+const double* nm_model_densities(const nm_model* model)
+{
+    return model != nullptr ? model->densities.data() : nullptr;
+}
+
+double nm_model_min_momentum(const nm_model* model)
+{
+    return model != nullptr ? model->sampler.MinMomentum() : 0.;
+}
+
+double nm_model_max_momentum(const nm_model* model)
+{
+    return model != nullptr ? model->sampler.MaxMomentum() : 0.;
+}
+
+double nm_model_norm(const nm_model* model)
+{
+    return model != nullptr ? model->sampler.Norm() : 0.;
+}
+
+int nm_evaluate(const nm_model* model, const double* momenta, double* densities, size_t count)
+{
+    if (model == nullptr || (count > 0 && (momenta == nullptr || densities == nullptr))) {
+        return NM_ERROR_ARGUMENT;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        densities[i] = model->sampler.Density(momenta[i]);
+    }
+    return NM_OK;
+}
+
+int nm_cdf(const nm_model* model, const double* momenta, double* probabilities, size_t count)
+{
+    if (model == nullptr || (count > 0 && (momenta == nullptr || probabilities == nullptr))) {
+        return NM_ERROR_ARGUMENT;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        probabilities[i] = model->sampler.Cdf(momenta[i]);
+    }
+    return NM_OK;
+}
+
+int nm_quantile(const nm_model* model, const double* probabilities, double* momenta, size_t count)
+{
+    if (model == nullptr || (count > 0 && (probabilities == nullptr || momenta == nullptr))) {
+        return NM_ERROR_ARGUMENT;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        momenta[i] = model->sampler.Quantile(probabilities[i]);
+    }
+    return NM_OK;
+}
+
+void nm_rng_seed(nm_rng* rng, uint64_t seed)
+{
+    if (rng == nullptr) {
+        return;
+    }
+    for (std::uint64_t& word : rng->state) {
+        word = SplitMix64(seed);
+    }
+}
+
+double nm_rng_uniform(nm_rng* rng)
+{
+    return rng != nullptr ? NextUniform(rng->state) : 0.;
+}
+
+int nm_sample(const nm_model* model, nm_rng* rng, double* momenta, size_t count)
+{
+    if (model == nullptr || rng == nullptr || (count > 0 && momenta == nullptr)) {
+        return NM_ERROR_ARGUMENT;
+    }
+    // The state is advanced in a local copy, which the compiler keeps in registers
+    std::uint64_t state[4] = {rng->state[0], rng->state[1], rng->state[2], rng->state[3]};
+    for (size_t i = 0; i < count; ++i) {
+        momenta[i] = model->sampler.Quantile(NextUniform(state));
+    }
+    std::memcpy(rng->state, state, sizeof(state));
+    return NM_OK;
+}
+
+} // extern "C"
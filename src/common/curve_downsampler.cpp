@@ -0,0 +1,134 @@
+/**
+ * @file curve_downsampler.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the CurveDownsampler class (Largest-Triangle-Three-Buckets).
+ *
+ * @details
+ * The algorithm follows S. Steinarsson, "Downsampling Time Series for Visual
+ * Representation" (2013). It runs in a single O(N) pass. The bucket holding
+ * the global maximum (or otherwise the global minimum) keeps that point
+ * instead of the largest-triangle one, so the peak of a momentum distribution
+ * is never cut.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/curve_downsampler.h"
+#include <cmath>
+
+/**
+ * LTTB selection for both floating-point types.
+ */
+template <typename T>
+static std::vector<std::size_t> SelectLttb(
+    const T* x, const T* y, std::size_t size, std::size_t target)
+{
+    std::vector<std::size_t> kept;
+    if (target < 3 || size <= target) {
+        kept.resize(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            kept[i] = i;
+        }
+        return kept;
+    }
+
+    std::size_t peak = 0, dip = 0;
+    for (std::size_t i = 1; i < size; ++i) {
+        if (y[i] > y[peak]) {peak = i;}
+        if (y[i] < y[dip]) {dip = i;}
+    }
+
+    kept.reserve(target);
+    kept.push_back(0);
+
+    // Interior points 1 .. size-2 are split into target-2 buckets
+    const double every = double(size - 2) / double(target - 2);
+    std::size_t previous = 0;
+
+    for (std::size_t bucket = 0; bucket < target - 2; ++bucket) {
+        std::size_t begin = std::size_t(std::floor(bucket * every)) + 1;
+        std::size_t end = std::size_t(std::floor((bucket + 1) * every)) + 1;
+        if (end > size - 1) {end = size - 1;}
+
+        // Average of the next bucket (the last point for the final bucket)
+        std::size_t next_begin = end;
+        std::size_t next_end = std::size_t(std::floor((bucket + 2) * every)) + 1;
+        if (bucket + 1 == target - 2 || next_end > size - 1) {
+            next_begin = size - 1;
+            next_end = size;
+        }
+        double avg_x = 0., avg_y = 0.;
+        for (std::size_t i = next_begin; i < next_end; ++i) {
+            avg_x += x[i];
+            avg_y += y[i];
+        }
+        avg_x /= double(next_end - next_begin);
+        avg_y /= double(next_end - next_begin);
+
+        std::size_t chosen = begin;
+        if (peak >= begin && peak < end) {
+            chosen = peak;
+        } else if (dip >= begin && dip < end) {
+            chosen = dip;
+        } else {
+            const double ax = x[previous], ay = y[previous];
+            double max_area = -1.;
+            for (std::size_t i = begin; i < end; ++i) {
+                double area = std::fabs((ax - avg_x) * (double(y[i]) - ay)
+                                      - (ax - double(x[i])) * (avg_y - ay));
+                if (area > max_area) {
+                    max_area = area;
+                    chosen = i;
+                }
+            }
+        }
+
+        kept.push_back(chosen);
+        previous = chosen;
+    }
+
+    kept.push_back(size - 1);
+    return kept;
+}
+
+template <typename T>
+static void Gather(
+    const T* x, const T* y, const std::vector<std::size_t>& kept,
+    std::vector<T>& out_x, std::vector<T>& out_y)
+{
+    out_x.resize(kept.size());
+    out_y.resize(kept.size());
+    for (std::size_t i = 0; i < kept.size(); ++i) {
+        out_x[i] = x[kept[i]];
+        out_y[i] = y[kept[i]];
+    }
+}
+
+std::vector<std::size_t> CurveDownsampler::SelectPoints(
+    const double* x, const double* y, std::size_t size) const
+{
+    return SelectLttb(x, y, size, target_points);
+}
+
+std::vector<std::size_t> CurveDownsampler::SelectPoints(
+    const float* x, const float* y, std::size_t size) const
+{
+    return SelectLttb(x, y, size, target_points);
+}
+
+void CurveDownsampler::Downsample(
+    const double* x, const double* y, std::size_t size,
+    std::vector<double>& out_x, std::vector<double>& out_y) const
+{
+    Gather(x, y, SelectPoints(x, y, size), out_x, out_y);
+}
+
+void CurveDownsampler::Downsample(
+    const float* x, const float* y, std::size_t size,
+    std::vector<float>& out_x, std::vector<float>& out_y) const
+{
+    Gather(x, y, SelectPoints(x, y, size), out_x, out_y);
+}
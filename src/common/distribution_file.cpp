@@ -0,0 +1,84 @@
+/**
+ * @file distribution_file.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the DistributionFile class for binary distribution files.
+ *
+ * @details
+ * Both columns are written with one call each, so writing a distribution costs
+ * a single pass over memory instead of formatting every number as text.
+ * Reading checks the magic and that the file holds exactly the announced
+ * number of points.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/distribution_file.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+constexpr char DistributionFile::MAGIC[8];
+
+bool DistributionFile::WriteBinary(
+    const std::string& file_path, const double* momenta,
+    const double* densities, std::size_t count)
+{
+    std::ofstream file(file_path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open output file: " << file_path << std::endl;
+        return false;
+    }
+
+    std::uint64_t points = count;
+    file.write(MAGIC, sizeof(MAGIC));
+    file.write(reinterpret_cast<const char*>(&points), sizeof(points));
+    file.write(reinterpret_cast<const char*>(momenta), count * sizeof(double));
+    file.write(reinterpret_cast<const char*>(densities), count * sizeof(double));
+    if (!file) {
+        std::cerr << "Error: Failed to write the output file: " << file_path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool DistributionFile::WriteBinary(
+    const std::string& file_path, const float* momenta,
+    const float* densities, std::size_t count)
+{
+    std::vector<double> momentum_column(momenta, momenta + count);
+    std::vector<double> density_column(densities, densities + count);
+    return WriteBinary(file_path, momentum_column.data(), density_column.data(), count);
+}
+
+bool DistributionFile::ReadBinary(
+    const std::string& file_path, std::vector<double>& momenta,
+    std::vector<double>& densities)
+{
+    std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open the data file: " << file_path << std::endl;
+        return false;
+    }
+    const std::uint64_t file_size = std::uint64_t(file.tellg());
+    file.seekg(0);
+
+    char magic[sizeof(MAGIC)];
+    std::uint64_t points = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&points), sizeof(points));
+    if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+        || points != (file_size - HEADER_SIZE) / (2 * sizeof(double))
+        || file_size != HEADER_SIZE + 2 * points * sizeof(double)) {
+        std::cerr << "Error: Not a valid binary distribution file: " << file_path << std::endl;
+        return false;
+    }
+
+    momenta.resize(points);
+    densities.resize(points);
+    file.read(reinterpret_cast<char*>(momenta.data()), points * sizeof(double));
+    file.read(reinterpret_cast<char*>(densities.data()), points * sizeof(double));
+    return bool(file);
+}
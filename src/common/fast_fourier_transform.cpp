@@ -0,0 +1,124 @@
+/**
+ * @file fast_fourier_transform.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the FastFourierTransform and SineTransform classes.
+ *
+ * @details
+ * Radial momentum distributions are isotropic, so their three-dimensional
+ * Fourier transforms reduce to sine transforms of rho(k)/k. The classes in
+ * this file provide an O(N log N) radix-2 FFT and a type-I discrete sine
+ * transform built on top of it, which replace direct O(N^2) sums in the
+ * folding and coordinate/momentum space transforms.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/fast_fourier_transform.h"
+#include <cmath>
+#include <utility>  // For std::swap
+
+const double TWO_PI = 6.28318530717958647692;
+
+/**
+ * Rounds a transform length up to the next power of two.
+ */
+static std::size_t NextPowerOfTwo(std::size_t requested)
+{
+    size_t size = 1;
+    while (size < requested) {
+        size <<= 1;
+    }
+    return size;
+}
+
+FastFourierTransform::FastFourierTransform(std::size_t requested)
+    : size(NextPowerOfTwo(requested))
+{
+    size_t bits = 0;
+    while ((size_t(1) << bits) < size) {
+        ++bits;
+    }
+
+    bit_reversed.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        size_t reversed = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        bit_reversed[i] = reversed;
+    }
+
+    twiddles.resize(size / 2);
+    for (size_t k = 0; k < size / 2; ++k) {
+        double angle = -TWO_PI * k / size;
+        twiddles[k] = {std::cos(angle), std::sin(angle)};
+    }
+}
+
+void FastFourierTransform::Forward(std::complex<double>* data) const
+{
+    Transform(data, false);
+}
+
+void FastFourierTransform::Inverse(std::complex<double>* data) const
+{
+    Transform(data, true);
+}
+
+/**
+ * Iterative Cooley-Tukey transform: bit-reversal permutation followed by
+ * log2(N) passes of butterflies using the cached twiddle factors.
+ */
+void FastFourierTransform::Transform(std::complex<double>* data, bool inverse) const
+{
+    for (size_t i = 0; i < size; ++i) {
+        size_t j = bit_reversed[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    for (size_t length = 2; length <= size; length <<= 1) {
+        size_t half = length / 2;
+        size_t stride = size / length;
+        for (size_t start = 0; start < size; start += length) {
+            for (size_t k = 0; k < half; ++k) {
+                std::complex<double> w = twiddles[k * stride];
+                if (inverse) {
+                    w = std::conj(w);
+                }
+                std::complex<double> odd = w * data[start + k + half];
+                data[start + k + half] = data[start + k] - odd;
+                data[start + k] += odd;
+            }
+        }
+    }
+}
+
+SineTransform::SineTransform(std::size_t requested)
+    : points(NextPowerOfTwo(requested)), fft(2 * points), work(2 * points) {}
+
+/**
+ * Builds the odd extension (0, f_1, ..., f_{N-1}, 0, -f_{N-1}, ..., -f_1),
+ * whose DFT is purely imaginary with Im X_m = -2 S_m.
+ */
+void SineTransform::Transform(const double* input, double* output) const
+{
+    const size_t n = points;
+    work[0] = 0.;
+    work[n] = 0.;
+    for (size_t j = 1; j < n; ++j) {
+        work[j] = input[j];
+        work[2 * n - j] = -input[j];
+    }
+
+    fft.Forward(work.data());
+
+    output[0] = 0.;
+    for (size_t m = 1; m < n; ++m) {
+        output[m] = -0.5 * work[m].imag();
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * @file file_watcher.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the FileWatcher class for waiting on file changes.
+ *
+ * @details
+ * One inotify watch is added per directory, reporting IN_CLOSE_WRITE (a file
+ * opened for writing was closed) and IN_MOVED_TO (a file was renamed into the
+ * directory). The events carry the file name, which is looked up among the
+ * watched names of that directory. Waiting uses poll: indefinitely for the
+ * first relevant event, then with the settle time as timeout. An eventfd is
+ * polled along with the inotify instance; Interrupt makes it readable for good,
+ * which ends every wait.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/file_watcher.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+FileWatcher::FileWatcher()
+{
+    descriptor = inotify_init1(IN_CLOEXEC);
+    if (descriptor < 0) {
+        std::cerr << "Error: Could not create the file watcher: " << std::strerror(errno) << std::endl;
+        return;
+    }
+    wake_descriptor = eventfd(0, EFD_CLOEXEC);
+    if (wake_descriptor < 0) {
+        std::cerr << "Error: Could not create the file watcher: " << std::strerror(errno) << std::endl;
+        close(descriptor);
+        descriptor = -1;
+    }
+}
+
+FileWatcher::~FileWatcher()
+{
+    if (descriptor >= 0) {
+        close(descriptor);
+    }
+    if (wake_descriptor >= 0) {
+        close(wake_descriptor);
+    }
+}
+
+void FileWatcher::Interrupt()
+{
+    if (wake_descriptor >= 0) {
+        eventfd_write(wake_descriptor, 1);
+    }
+}
+
+bool FileWatcher::Add(const std::string& file_path)
+{
+    if (descriptor < 0) {
+        return false;
+    }
+    std::size_t slash = file_path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : file_path.substr(0, slash);
+    std::string name = slash == std::string::npos ? file_path : file_path.substr(slash + 1);
+    if (directory.empty()) {
+        directory = "/";
+    }
+
+    // Adding the same directory again returns its existing watch descriptor
+    int watch = inotify_add_watch(descriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watch < 0) {
+        std::cerr << "Error: Could not watch " << directory << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    watches[watch][name] = file_path;
+    return true;
+}
+
+std::vector<std::string> FileWatcher::WaitForChanges(int settle_ms)
+{
+    std::set<std::string> changed;
+    if (descriptor < 0) {
+        return {};
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    int timeout = -1;
+    for (;;) {
+        pollfd requests[2] = {{descriptor, POLLIN, 0}, {wake_descriptor, POLLIN, 0}};
+        int ready = poll(requests, 2, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) {continue;}
+            std::cerr << "Error: Waiting for file changes failed: " << std::strerror(errno) << std::endl;
+            return {};
+        }
+        if (ready == 0) {
+            break; // No further events within the settle time
+        }
+        if (requests[1].revents != 0) {
+            return {};
+        }
+
+        ssize_t length = read(descriptor, buffer, sizeof(buffer));
+        if (length < 0) {
+            if (errno == EINTR || errno == EAGAIN) {continue;}
+            std::cerr << "Error: Reading file events failed: " << std::strerror(errno) << std::endl;
+            return {};
+        }
+        for (ssize_t offset = 0; offset < length; ) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+            auto directory = watches.find(event->wd);
+            if (event->len == 0 || directory == watches.end()) {
+                continue;
+            }
+            auto file = directory->second.find(event->name);
+            if (file != directory->second.end()) {
+                changed.insert(file->second);
+            }
+        }
+        if (!changed.empty()) {
+            timeout = settle_ms;
+        }
+    }
+    return std::vector<std::string>(changed.begin(), changed.end());
+}
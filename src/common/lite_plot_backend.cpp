@@ -0,0 +1,806 @@
+/**
+ * @file lite_plot_backend.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the LitePlotBackend class, a ROOT-free SVG/PNG plot renderer.
+ *
+ * @details
+ * The layout of a plot (frame, ticks, labels, curves, legend) is computed once
+ * in DrawPlot and issued as a handful of drawing primitives to a Painter. The
+ * SvgPainter turns them into SVG elements; the RasterPainter draws them into
+ * an RGB buffer that is written with PngWriter. Text in raster images uses the
+ * classic 5x7 bitmap font, scaled by an integer factor. The PdfPainter emits
+ * PDF operators for PdfWriter, either as a single-page file or as one page of
+ * an open multi-page document.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/lite_plot_backend.h"
+#include "../include/common/pdf_writer.h"
+#include "../include/common/png_writer.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+const double FRAME_MARGIN = 0.1;    // Canvas fraction left free around the frame
+const double TICK_LENGTH = 0.03;    // Tick length as a fraction of the frame
+const int AXIS_DIVISIONS = 10;      // Approximate number of labelled ticks
+const int TITLE_SIZE = 3;           // Font scale of the plot title
+const int LABEL_SIZE = 2;           // Font scale of axis labels and titles
+const int GLYPH_WIDTH = 5;          // Bitmap font glyph width in pixels
+const int GLYPH_HEIGHT = 7;         // Bitmap font glyph height in pixels
+const int GLYPH_ADVANCE = 6;        // Horizontal advance per character
+
+/**
+ * 5x7 bitmap font for the printable ASCII characters 32-126. Every glyph is
+ * stored as five columns from left to right; bit 0 is the top row.
+ */
+static const std::uint8_t FONT_5X7[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00},
+    {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7F, 0x14, 0x7F, 0x14},
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00},
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1C, 0x00},
+    {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08},
+    {0x00, 0x60, 0x60, 0x00, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02},
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31},
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39},
+    {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E},
+    {0x00, 0x36, 0x36, 0x00, 0x00}, {0x00, 0x56, 0x36, 0x00, 0x00},
+    {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06},
+    {0x32, 0x49, 0x79, 0x41, 0x3E}, {0x7E, 0x11, 0x11, 0x11, 0x7E},
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41},
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, {0x3E, 0x41, 0x49, 0x49, 0x7A},
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41},
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, {0x7F, 0x02, 0x0C, 0x02, 0x7F},
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E},
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x46, 0x49, 0x49, 0x49, 0x31},
+    {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F},
+    {0x63, 0x14, 0x08, 0x14, 0x63}, {0x07, 0x08, 0x70, 0x08, 0x07},
+    {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00},
+    {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40},
+    {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20},
+    {0x38, 0x44, 0x44, 0x48, 0x7F}, {0x38, 0x54, 0x54, 0x54, 0x18},
+    {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x0C, 0x52, 0x52, 0x52, 0x3E},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00},
+    {0x20, 0x40, 0x44, 0x3D, 0x00}, {0x7F, 0x10, 0x28, 0x44, 0x00},
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38},
+    {0x7C, 0x14, 0x14, 0x14, 0x08}, {0x08, 0x14, 0x14, 0x18, 0x7C},
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C},
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, {0x3C, 0x40, 0x30, 0x40, 0x3C},
+    {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00},
+    {0x00, 0x00, 0x7F, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00},
+    {0x08, 0x04, 0x08, 0x10, 0x08}
+};
+
+struct Rgb {
+    std::uint8_t r, g, b;
+};
+
+const Rgb BLACK = {0, 0, 0};
+const Rgb WHITE = {255, 255, 255};
+
+/**
+ * Maps a ROOT colour index to RGB (the basic colours 0-9, repeated cyclically).
+ */
+static Rgb PaletteColor(int index)
+{
+    static const Rgb palette[10] = {
+        {255, 255, 255}, {0, 0, 0}, {255, 0, 0}, {0, 255, 0}, {0, 0, 255},
+        {255, 255, 0}, {255, 0, 255}, {0, 255, 255}, {89, 212, 84}, {89, 84, 216}
+    };
+    if (index < 0) {
+        index = 1;
+    }
+    return index < 10 ? palette[index] : palette[1 + (index - 1) % 9];
+}
+
+/**
+ * Dash pattern (on, off, ...) in pixels for a ROOT line style; empty if solid.
+ */
+static std::vector<double> DashPattern(int line_style)
+{
+    switch (line_style) {
+        case 2: return {12., 8.};
+        case 3: return {2., 4.};
+        case 4: return {12., 6., 2., 6.};
+        default: return {};
+    }
+}
+
+enum class Anchor { kStart, kMiddle, kEnd };
+
+using Point = std::pair<double, double>;
+
+/**
+ * Drawing primitives shared by the SVG and raster output. Coordinates are
+ * pixels with the origin in the upper left corner.
+ */
+class Painter {
+public:
+    virtual ~Painter() = default;
+    virtual void Line(double x0, double y0, double x1, double y1, Rgb color, int width) = 0;
+    virtual void Polyline(const std::vector<Point>& points, Rgb color, int width,
+                          int line_style) = 0;
+    virtual void Marker(double x, double y, double radius, Rgb color) = 0;
+    virtual void Rectangle(double x0, double y0, double x1, double y1, bool fill) = 0;
+    virtual void Text(double x, double y, const std::string& text, int scale,
+                      Anchor anchor, bool vertical) = 0;
+    virtual void SetClip(double x0, double y0, double x1, double y1) = 0;
+    virtual void ResetClip() = 0;
+
+    /**
+     * Width of a text in pixels at a given font scale.
+     */
+    static double TextWidth(const std::string& text, int scale) {
+        return text.empty() ? 0. : double(GLYPH_ADVANCE * text.size() - 1) * scale;
+    }
+};
+
+/**
+ * Writes the primitives as SVG elements.
+ */
+class SvgPainter : public Painter {
+public:
+    SvgPainter(int width, int height) {
+        body << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << width
+             << "\" height=\"" << height << "\" viewBox=\"0 0 " << width << ' '
+             << height << "\">\n<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+    }
+
+    void Line(double x0, double y0, double x1, double y1, Rgb color, int width) override {
+        body << "<line x1=\"" << x0 << "\" y1=\"" << y0 << "\" x2=\"" << x1
+             << "\" y2=\"" << y1 << "\" stroke=\"" << Color(color)
+             << "\" stroke-width=\"" << width << "\"/>\n";
+    }
+
+    void Polyline(const std::vector<Point>& points, Rgb color, int width,
+                  int line_style) override {
+        body << "<polyline" << ClipAttribute() << " fill=\"none\" stroke=\""
+             << Color(color) << "\" stroke-width=\"" << width << '"';
+        std::vector<double> dashes = DashPattern(line_style);
+        if (!dashes.empty()) {
+            body << " stroke-dasharray=\"";
+            for (size_t i = 0; i < dashes.size(); ++i) {
+                body << (i > 0 ? "," : "") << dashes[i];
+            }
+            body << '"';
+        }
+        body << " points=\"";
+        for (const Point& point : points) {
+            body << point.first << ',' << point.second << ' ';
+        }
+        body << "\"/>\n";
+    }
+
+    void Marker(double x, double y, double radius, Rgb color) override {
+        body << "<circle" << ClipAttribute() << " cx=\"" << x << "\" cy=\"" << y
+             << "\" r=\"" << radius << "\" fill=\"" << Color(color) << "\"/>\n";
+    }
+
+    void Rectangle(double x0, double y0, double x1, double y1, bool fill) override {
+        body << "<rect x=\"" << x0 << "\" y=\"" << y0 << "\" width=\"" << x1 - x0
+             << "\" height=\"" << y1 - y0 << "\" fill=\"" << (fill ? "white" : "none")
+             << "\" stroke=\"black\" stroke-width=\"1\"/>\n";
+    }
+
+    void Text(double x, double y, const std::string& text, int scale,
+              Anchor anchor, bool vertical) override {
+        static const char* anchors[] = {"start", "middle", "end"};
+        body << "<text x=\"" << x << "\" y=\"" << y << "\" font-family=\"sans-serif\""
+             << " font-size=\"" << 7 * scale << "\" text-anchor=\""
+             << anchors[int(anchor)] << "\" dominant-baseline=\"middle\"";
+        if (vertical) {
+            body << " transform=\"rotate(-90 " << x << ' ' << y << ")\"";
+        }
+        body << '>' << Escape(text) << "</text>\n";
+    }
+
+    void SetClip(double x0, double y0, double x1, double y1) override {
+        ++clip_id;
+        body << "<clipPath id=\"clip" << clip_id << "\"><rect x=\"" << x0 << "\" y=\""
+             << y0 << "\" width=\"" << x1 - x0 << "\" height=\"" << y1 - y0
+             << "\"/></clipPath>\n";
+        clipped = true;
+    }
+
+    void ResetClip() override { clipped = false; }
+
+    bool Save(const std::string& file_path) {
+        std::ofstream file(file_path);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open output file: " << file_path << std::endl;
+            return false;
+        }
+        file << body.str() << "</svg>\n";
+        return bool(file);
+    }
+
+private:
+    std::ostringstream body;
+    int clip_id = 0;
+    bool clipped = false;
+
+    std::string ClipAttribute() const {
+        return clipped ? " clip-path=\"url(#clip" + std::to_string(clip_id) + ")\"" : "";
+    }
+
+    static std::string Color(Rgb color) {
+        char buffer[8];
+        std::snprintf(buffer, sizeof(buffer), "#%02x%02x%02x", color.r, color.g, color.b);
+        return buffer;
+    }
+
+    static std::string Escape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            switch (c) {
+                case '&': escaped += "&amp;"; break;
+                case '<': escaped += "&lt;"; break;
+                case '>': escaped += "&gt;"; break;
+                default: escaped += c;
+            }
+        }
+        return escaped;
+    }
+};
+
+/**
+ * Draws the primitives into an RGB buffer. Lines are stamped with a square
+ * brush of the line width every half pixel, which keeps the code short and is
+ * indistinguishable from a proper scan conversion at plot resolution.
+ */
+class RasterPainter : public Painter {
+public:
+    RasterPainter(int width, int height)
+        : width(width), height(height), pixels(std::size_t(width) * height * 3, 255),
+          clip_x0(0), clip_y0(0), clip_x1(width), clip_y1(height) {}
+
+    void Line(double x0, double y0, double x1, double y1, Rgb color, int line_width) override {
+        Polyline({{x0, y0}, {x1, y1}}, color, line_width, 1);
+    }
+
+    void Polyline(const std::vector<Point>& points, Rgb color, int line_width,
+                  int line_style) override {
+        std::vector<double> dashes = DashPattern(line_style);
+        double period = 0.;
+        for (double dash : dashes) {
+            period += dash;
+        }
+
+        double travelled = 0.;  // Path length for the dash pattern
+        for (size_t i = 1; i < points.size(); ++i) {
+            double dx = points[i].first - points[i - 1].first;
+            double dy = points[i].second - points[i - 1].second;
+            double length = std::sqrt(dx * dx + dy * dy);
+            int steps = std::max(1, int(std::ceil(2. * length)));
+            for (int s = 0; s <= steps; ++s) {
+                double t = double(s) / steps;
+                if (period > 0. && !IsDashOn(dashes, std::fmod(travelled + t * length, period))) {
+                    continue;
+                }
+                Stamp(points[i - 1].first + t * dx, points[i - 1].second + t * dy,
+                      line_width, color);
+            }
+            travelled += length;
+        }
+    }
+
+    void Marker(double x, double y, double radius, Rgb color) override {
+        int r = int(std::ceil(radius));
+        for (int py = -r; py <= r; ++py) {
+            for (int px = -r; px <= r; ++px) {
+                if (px * px + py * py <= radius * radius) {
+                    Set(int(std::lround(x)) + px, int(std::lround(y)) + py, color);
+                }
+            }
+        }
+    }
+
+    void Rectangle(double x0, double y0, double x1, double y1, bool fill) override {
+        if (fill) {
+            for (int py = int(y0); py <= int(y1); ++py) {
+                for (int px = int(x0); px <= int(x1); ++px) {
+                    Set(px, py, WHITE);
+                }
+            }
+        }
+        Line(x0, y0, x1, y0, BLACK, 1);
+        Line(x1, y0, x1, y1, BLACK, 1);
+        Line(x1, y1, x0, y1, BLACK, 1);
+        Line(x0, y1, x0, y0, BLACK, 1);
+    }
+
+    void Text(double x, double y, const std::string& text, int scale,
+              Anchor anchor, bool vertical) override {
+        double offset = TextWidth(text, scale);
+        offset *= anchor == Anchor::kStart ? 0. : anchor == Anchor::kMiddle ? 0.5 : 1.;
+        // Position of the upper left corner of the first glyph along the text direction
+        double along = -offset;
+        double across = -0.5 * GLYPH_HEIGHT * scale;
+
+        for (char c : text) {
+            int code = static_cast<unsigned char>(c);
+            const std::uint8_t* glyph = FONT_5X7[(code >= 32 && code < 127) ? code - 32 : '?' - 32];
+            for (int column = 0; column < GLYPH_WIDTH; ++column) {
+                for (int row = 0; row < GLYPH_HEIGHT; ++row) {
+                    if (!(glyph[column] & (1 << row))) {
+                        continue;
+                    }
+                    for (int sy = 0; sy < scale; ++sy) {
+                        for (int sx = 0; sx < scale; ++sx) {
+                            double u = along + column * scale + sx;
+                            double v = across + row * scale + sy;
+                            if (vertical) {
+                                Set(int(std::lround(x + v)), int(std::lround(y - u)), BLACK);
+                            } else {
+                                Set(int(std::lround(x + u)), int(std::lround(y + v)), BLACK);
+                            }
+                        }
+                    }
+                }
+            }
+            along += GLYPH_ADVANCE * scale;
+        }
+    }
+
+    void SetClip(double x0, double y0, double x1, double y1) override {
+        clip_x0 = int(std::floor(x0));
+        clip_y0 = int(std::floor(y0));
+        clip_x1 = int(std::ceil(x1)) + 1;
+        clip_y1 = int(std::ceil(y1)) + 1;
+    }
+
+    void ResetClip() override {
+        clip_x0 = 0;
+        clip_y0 = 0;
+        clip_x1 = width;
+        clip_y1 = height;
+    }
+
+    bool Save(const std::string& file_path) const {
+        return PngWriter::Write(file_path, width, height, pixels);
+    }
+
+private:
+    int width, height;
+    std::vector<std::uint8_t> pixels;
+    int clip_x0, clip_y0, clip_x1, clip_y1;  // Drawable area [x0, x1) x [y0, y1)
+
+    void Set(int x, int y, Rgb color) {
+        if (x < clip_x0 || x >= clip_x1 || y < clip_y0 || y >= clip_y1) {
+            return;
+        }
+        std::uint8_t* pixel = &pixels[(std::size_t(y) * width + x) * 3];
+        pixel[0] = color.r;
+        pixel[1] = color.g;
+        pixel[2] = color.b;
+    }
+
+    void Stamp(double x, double y, int size, Rgb color) {
+        int x0 = int(std::lround(x - 0.5 * (size - 1)));
+        int y0 = int(std::lround(y - 0.5 * (size - 1)));
+        for (int py = 0; py < size; ++py) {
+            for (int px = 0; px < size; ++px) {
+                Set(x0 + px, y0 + py, color);
+            }
+        }
+    }
+
+    static bool IsDashOn(const std::vector<double>& dashes, double position) {
+        for (size_t i = 0; i < dashes.size(); ++i) {
+            if (position < dashes[i]) {
+                return i % 2 == 0;
+            }
+            position -= dashes[i];
+        }
+        return false;
+    }
+};
+
+/**
+ * Writes the primitives as a PDF content stream. The page is flipped once so
+ * that the pixel coordinates of the layout can be used unchanged; text gets
+ * a mirrored text matrix to stay upright. Text is set in Helvetica.
+ */
+class PdfPainter : public Painter {
+public:
+    explicit PdfPainter(int height) {
+        content << std::fixed << std::setprecision(2);
+        content << "q 1 0 0 -1 0 " << height << " cm 1 J 1 j\n";
+    }
+
+    void Line(double x0, double y0, double x1, double y1, Rgb color, int width) override {
+        Stroke(color, width);
+        content << x0 << ' ' << y0 << " m " << x1 << ' ' << y1 << " l S\n";
+    }
+
+    void Polyline(const std::vector<Point>& points, Rgb color, int width,
+                  int line_style) override {
+        if (points.empty()) {
+            return;
+        }
+        Stroke(color, width);
+        std::vector<double> dashes = DashPattern(line_style);
+        if (!dashes.empty()) {
+            content << '[';
+            for (double dash : dashes) {
+                content << dash << ' ';
+            }
+            content << "] 0 d\n";
+        }
+        content << points[0].first << ' ' << points[0].second << " m\n";
+        for (size_t i = 1; i < points.size(); ++i) {
+            content << points[i].first << ' ' << points[i].second << " l\n";
+        }
+        content << "S\n";
+        if (!dashes.empty()) {
+            content << "[] 0 d\n";
+        }
+    }
+
+    void Marker(double x, double y, double radius, Rgb color) override {
+        // Circle from four cubic Bezier arcs
+        const double k = 0.5523 * radius;
+        Fill(color);
+        content << x + radius << ' ' << y << " m "
+                << x + radius << ' ' << y + k << ' ' << x + k << ' ' << y + radius << ' '
+                << x << ' ' << y + radius << " c "
+                << x - k << ' ' << y + radius << ' ' << x - radius << ' ' << y + k << ' '
+                << x - radius << ' ' << y << " c "
+                << x - radius << ' ' << y - k << ' ' << x - k << ' ' << y - radius << ' '
+                << x << ' ' << y - radius << " c "
+                << x + k << ' ' << y - radius << ' ' << x + radius << ' ' << y - k << ' '
+                << x + radius << ' ' << y << " c f\n";
+    }
+
+    void Rectangle(double x0, double y0, double x1, double y1, bool fill) override {
+        Stroke(BLACK, 1);
+        if (fill) {
+            Fill(WHITE);
+        }
+        content << x0 << ' ' << y0 << ' ' << x1 - x0 << ' ' << y1 - y0
+                << (fill ? " re B\n" : " re S\n");
+    }
+
+    void Text(double x, double y, const std::string& text, int scale,
+              Anchor anchor, bool vertical) override {
+        const double size = 7. * scale;
+        double offset = PdfWriter::TextWidth(text) * size;
+        offset *= anchor == Anchor::kStart ? 0. : anchor == Anchor::kMiddle ? 0.5 : 1.;
+        const double baseline = 0.35 * size;  // From the centre line to the baseline
+
+        Fill(BLACK);
+        content << "BT /F1 " << size << " Tf ";
+        if (vertical) {
+            content << "0 -1 -1 0 " << x + baseline << ' ' << y + offset;
+        } else {
+            content << "1 0 0 -1 " << x - offset << ' ' << y + baseline;
+        }
+        content << " Tm (" << Escape(text) << ") Tj ET\n";
+    }
+
+    void SetClip(double x0, double y0, double x1, double y1) override {
+        ResetClip();
+        content << "q " << x0 << ' ' << y0 << ' ' << x1 - x0 << ' ' << y1 - y0
+                << " re W n\n";
+        clipped = true;
+    }
+
+    void ResetClip() override {
+        if (clipped) {
+            content << "Q\n";
+            clipped = false;
+        }
+    }
+
+    std::string Content() {
+        ResetClip();
+        return content.str() + "Q\n";
+    }
+
+private:
+    std::ostringstream content;
+    bool clipped = false;
+
+    void Stroke(Rgb color, int width) {
+        content << color.r / 255. << ' ' << color.g / 255. << ' ' << color.b / 255.
+                << " RG " << width << " w\n";
+    }
+
+    void Fill(Rgb color) {
+        content << color.r / 255. << ' ' << color.g / 255. << ' ' << color.b / 255.
+                << " rg\n";
+    }
+
+    static std::string Escape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '(' || c == ')' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+};
+
+/**
+ * Chooses a tick spacing of 1, 2 or 5 times a power of ten giving about the
+ * requested number of divisions.
+ */
+static double NiceStep(double range, int divisions)
+{
+    double raw = range / divisions;
+    double magnitude = std::pow(10., std::floor(std::log10(raw)));
+    double fraction = raw / magnitude;
+    double nice = fraction < 1.5 ? 1. : fraction < 3.5 ? 2. : fraction < 7.5 ? 5. : 10.;
+    return nice * magnitude;
+}
+
+/**
+ * Formats a tick label with as many decimals as the tick spacing requires.
+ */
+static std::string TickLabel(double value, double step)
+{
+    int decimals = std::max(0, -int(std::floor(std::log10(step) + 1e-9)));
+    if (std::fabs(value) < 0.5 * step) {
+        value = 0.;
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    return buffer;
+}
+
+/**
+ * Determines an axis range from the spec or, if none is given, from the data
+ * with a margin of 5% on both sides (not below zero for non-negative data).
+ */
+static void AxisRange(
+    const PlotSpec& spec, bool x_axis, double& low, double& high)
+{
+    low = x_axis ? spec.x_min : spec.y_min;
+    high = x_axis ? spec.x_max : spec.y_max;
+    if (high > low) {
+        return;
+    }
+
+    low = HUGE_VAL;
+    high = -HUGE_VAL;
+    for (const PlotCurve& curve : spec.curves) {
+        const std::vector<double>& values = x_axis ? curve.x : curve.y;
+        for (double value : values) {
+            if (std::isfinite(value)) {
+                low = std::min(low, value);
+                high = std::max(high, value);
+            }
+        }
+    }
+    if (!(high >= low)) {
+        low = 0.;
+        high = 1.;
+    }
+    if (high == low) {
+        high = low + (low != 0. ? std::fabs(low) : 1.);
+    }
+
+    double margin = 0.05 * (high - low);
+    bool non_negative = low >= 0.;
+    low -= margin;
+    high += margin;
+    if (non_negative && low < 0.) {
+        low = 0.;
+    }
+}
+
+/**
+ * Largest font scale up to the preferred one at which a text fits a width.
+ */
+static int FitScale(const std::string& text, int preferred, double width)
+{
+    int scale = preferred;
+    while (scale > 1 && Painter::TextWidth(text, scale) > width) {
+        --scale;
+    }
+    return scale;
+}
+
+/**
+ * Lays out and draws a complete plot with the given painter.
+ */
+static void DrawPlot(const PlotSpec& spec, Painter& painter)
+{
+    double x_low, x_high, y_low, y_high;
+    AxisRange(spec, true, x_low, x_high);
+    AxisRange(spec, false, y_low, y_high);
+    const double x_step = NiceStep(x_high - x_low, AXIS_DIVISIONS);
+    const double y_step = NiceStep(y_high - y_low, AXIS_DIVISIONS);
+    const double label_gap = GLYPH_HEIGHT * LABEL_SIZE;
+
+    // The left margin grows when the y labels and the y title do not fit in it
+    double label_width = 0.;
+    for (double y = std::ceil(y_low / y_step - 1e-9) * y_step; y <= y_high + 1e-9 * y_step;
+         y += y_step) {
+        label_width = std::max(label_width, Painter::TextWidth(TickLabel(y, y_step), LABEL_SIZE));
+    }
+    const double left = std::max(FRAME_MARGIN * spec.width,
+                                 label_width + 2.5 * label_gap);
+    const double right = (1. - FRAME_MARGIN) * spec.width;
+    const double top = FRAME_MARGIN * spec.height;
+    const double bottom = (1. - FRAME_MARGIN) * spec.height;
+    auto to_x = [&](double x) { return left + (x - x_low) / (x_high - x_low) * (right - left); };
+    auto to_y = [&](double y) { return bottom - (y - y_low) / (y_high - y_low) * (bottom - top); };
+
+    // Frame, ticks and tick labels
+    painter.Rectangle(left, top, right, bottom, false);
+    const double x_tick = TICK_LENGTH * (bottom - top);
+    const double y_tick = TICK_LENGTH * (right - left) * 0.5;
+
+    for (double x = std::ceil(x_low / x_step - 1e-9) * x_step; x <= x_high + 1e-9 * x_step;
+         x += x_step) {
+        painter.Line(to_x(x), bottom, to_x(x), bottom - x_tick, BLACK, 1);
+        painter.Text(to_x(x), bottom + label_gap, TickLabel(x, x_step),
+                     LABEL_SIZE, Anchor::kMiddle, false);
+    }
+    for (double y = std::ceil(y_low / y_step - 1e-9) * y_step; y <= y_high + 1e-9 * y_step;
+         y += y_step) {
+        painter.Line(left, to_y(y), left + y_tick, to_y(y), BLACK, 1);
+        painter.Text(left - 0.5 * label_gap, to_y(y), TickLabel(y, y_step),
+                     LABEL_SIZE, Anchor::kEnd, false);
+    }
+
+    // Axis titles at the far ends of the axes, as in ROOT
+    painter.Text(right, bottom + 2.6 * label_gap, spec.x_title, LABEL_SIZE,
+                 Anchor::kEnd, false);
+    painter.Text(0.75 * label_gap, top, spec.y_title, LABEL_SIZE, Anchor::kEnd, true);
+    painter.Text(0.5 * spec.width, 0.5 * top, spec.title,
+                 FitScale(spec.title, TITLE_SIZE, spec.width - 2. * label_gap),
+                 Anchor::kMiddle, false);
+
+    // Curves, clipped to the frame
+    painter.SetClip(left, top, right, bottom);
+    for (const PlotCurve& curve : spec.curves) {
+        const size_t n = std::min(curve.x.size(), curve.y.size());
+        std::vector<Point> points;
+        points.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            points.push_back({to_x(curve.x[i]), to_y(curve.y[i])});
+        }
+        Rgb color = PaletteColor(curve.color);
+        if (curve.draw_line && n > 1) {
+            painter.Polyline(points, color, curve.line_width, curve.line_style);
+        }
+        if (curve.draw_markers) {
+            for (const Point& point : points) {
+                painter.Marker(point.first, point.second, 4. * curve.marker_size, color);
+            }
+        }
+    }
+    painter.ResetClip();
+
+    // Legend in the upper right corner: line sample, marker and label per entry
+    if (!spec.show_legend) {
+        return;
+    }
+    std::vector<const PlotCurve*> entries;
+    for (const PlotCurve& curve : spec.curves) {
+        if (!curve.label.empty()) {
+            entries.push_back(&curve);
+        }
+    }
+    if (entries.empty()) {
+        return;
+    }
+
+    // The box widens to the left, up to the middle of the frame, for long labels
+    std::string longest;
+    for (const PlotCurve* curve : entries) {
+        if (curve->label.size() > longest.size()) {longest = curve->label;}
+    }
+    const double sample = 0.05 * spec.width;
+    const double box_right = right;
+    const double box_left = std::max(0.5 * (left + right),
+        std::min(0.7 * spec.width,
+                 box_right - sample - 16. - Painter::TextWidth(longest, LABEL_SIZE)));
+    const double box_top = top, box_bottom = 0.3 * spec.height;
+    painter.Rectangle(box_left, box_top, box_right, box_bottom, true);
+
+    const double row_height = (box_bottom - box_top) / entries.size();
+    int scale = FitScale(longest, LABEL_SIZE, box_right - box_left - sample - 16.);
+    while (scale > 1 && GLYPH_HEIGHT * scale > row_height) {
+        --scale;
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const PlotCurve& curve = *entries[i];
+        double y = box_top + (i + 0.5) * row_height;
+        double x0 = box_left + 4., x1 = box_left + 4. + sample;
+        Rgb color = PaletteColor(curve.color);
+        if (curve.draw_line) {
+            painter.Polyline({{x0, y}, {x1, y}}, color, curve.line_width, curve.line_style);
+        }
+        if (curve.draw_markers) {
+            painter.Marker(0.5 * (x0 + x1), y, 4. * curve.marker_size, color);
+        }
+        painter.Text(x1 + 8., y, curve.label, scale, Anchor::kStart, false);
+    }
+}
+
+bool LitePlotBackend::Render(const PlotSpec& spec, const std::string& output_path)
+{
+    std::string extension;
+    size_t dot = output_path.find_last_of('.');
+    if (dot != std::string::npos) {
+        extension = output_path.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return char(std::tolower(c)); });
+    }
+
+    if (extension == "svg") {
+        SvgPainter painter(spec.width, spec.height);
+        DrawPlot(spec, painter);
+        return painter.Save(output_path);
+    }
+    if (extension == "png") {
+        RasterPainter painter(spec.width, spec.height);
+        DrawPlot(spec, painter);
+        return painter.Save(output_path);
+    }
+    if (extension == "pdf") {
+        PdfWriter writer;
+        return writer.Open(output_path) && WritePage(spec, writer) && writer.Close();
+    }
+
+    std::cerr << "Error: The lite plot backend writes only .svg, .png and .pdf files: "
+              << output_path << std::endl;
+    return false;
+}
+
+bool LitePlotBackend::OpenDocument(const std::string& output_path)
+{
+    return document.Open(output_path);
+}
+
+bool LitePlotBackend::AddPage(const PlotSpec& spec)
+{
+    return WritePage(spec, document);
+}
+
+bool LitePlotBackend::CloseDocument()
+{
+    return document.Close();
+}
+
+/**
+ * Draws a plot as one PDF page of the size of the canvas.
+ */
+bool LitePlotBackend::WritePage(const PlotSpec& spec, PdfWriter& writer)
+{
+    PdfPainter painter(spec.height);
+    DrawPlot(spec, painter);
+    return writer.AddPage(spec.width, spec.height, painter.Content());
+}
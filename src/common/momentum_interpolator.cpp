@@ -0,0 +1,343 @@
+/**
+ * @file momentum_interpolator.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the MomentumInterpolator class for evaluating
+ *        tabulated momentum distributions between the tabulated points.
+ *
+ * @details
+ * The MomentumInterpolator class turns a table of momenta and probability
+ * densities into a piecewise cubic function. Linear, natural cubic spline and
+ * monotone PCHIP interpolation are all stored as per-segment polynomial
+ * coefficients, so a query reduces to locating the segment and a Horner
+ * evaluation. Locating the segment is a single multiplication for equidistant
+ * grids and a branch-free binary search otherwise, which keeps per-event
+ * queries from kinematic weighting code cheap.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/momentum_interpolator.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+const double UNIFORM_GRID_TOLERANCE = 1e-3; // Allowed knot deviation relative to the step
+
+MomentumInterpolator::MomentumInterpolator(
+    const std::vector<std::pair<float, float>>& data, InterpolationMethod method)
+    : method(method)
+{
+    std::vector<double> densities;
+    knots.reserve(data.size());
+    densities.reserve(data.size());
+    for (const auto& [momentum, density] : data) {
+        knots.push_back(momentum);
+        densities.push_back(density);
+    }
+    Build(densities);
+}
+
+MomentumInterpolator::MomentumInterpolator(
+    const std::vector<double>& momenta, const std::vector<double>& densities,
+    InterpolationMethod method)
+    : method(method), knots(momenta)
+{
+    if (momenta.size() != densities.size()) {
+        std::cerr << "Error: Momentum and density columns differ in length ("
+                  << momenta.size() << " vs " << densities.size() << ")."
+                  << std::endl;
+        knots.clear();
+        return;
+    }
+    Build(densities);
+}
+
+/**
+ * Validates the table and dispatches to the coefficient builder for the
+ * selected interpolation scheme.
+ */
+void MomentumInterpolator::Build(const std::vector<double>& densities)
+{
+    if (knots.size() < 2) {
+        std::cerr << "Error: At least two points are required for interpolation."
+                  << std::endl;
+        knots.clear();
+        return;
+    }
+    for (size_t i = 1; i < knots.size(); ++i) {
+        if (!(knots[i] > knots[i - 1])) {
+            std::cerr << "Error: Momenta must be strictly increasing (row "
+                      << i << ")." << std::endl;
+            knots.clear();
+            return;
+        }
+    }
+
+    switch (method) {
+        case InterpolationMethod::kLinear: {
+            // A linear segment is a Hermite cubic with secant slopes and c = d = 0
+            size_t n = knots.size() - 1;
+            coeff_a.assign(densities.begin(), densities.end() - 1);
+            coeff_b.resize(n);
+            coeff_c.assign(n, 0.);
+            coeff_d.assign(n, 0.);
+            for (size_t i = 0; i < n; ++i) {
+                coeff_b[i] = (densities[i + 1] - densities[i])
+                           / (knots[i + 1] - knots[i]);
+            }
+            break;
+        }
+        case InterpolationMethod::kCubicSpline:
+            BuildCubicSpline(densities);
+            break;
+        case InterpolationMethod::kPchip:
+            BuildFromSlopes(densities, PchipSlopes(densities));
+            break;
+    }
+
+    DetectUniformGrid();
+}
+
+/**
+ * Converts knot values and slopes into the coefficients of the cubic Hermite
+ * polynomial a + b*t + c*t^2 + d*t^3 on each segment, with t = p - p_i.
+ */
+void MomentumInterpolator::BuildFromSlopes(
+    const std::vector<double>& densities, const std::vector<double>& slopes)
+{
+    size_t n = knots.size() - 1;
+    coeff_a.assign(densities.begin(), densities.end() - 1);
+    coeff_b.assign(slopes.begin(), slopes.end() - 1);
+    coeff_c.resize(n);
+    coeff_d.resize(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        double h = knots[i + 1] - knots[i];
+        double delta = (densities[i + 1] - densities[i]) / h;
+        coeff_c[i] = (3. * delta - 2. * slopes[i] - slopes[i + 1]) / h;
+        coeff_d[i] = (slopes[i] + slopes[i + 1] - 2. * delta) / (h * h);
+    }
+}
+
+/**
+ * Solves the tridiagonal system for the second derivatives of a natural cubic
+ * spline (Thomas algorithm) and converts them into segment coefficients.
+ */
+void MomentumInterpolator::BuildCubicSpline(const std::vector<double>& densities)
+{
+    size_t n = knots.size() - 1;
+    std::vector<double> m2(n + 1, 0.);  // Second derivatives, zero at both ends
+
+    if (n > 1) {
+        std::vector<double> diag(n + 1), rhs(n + 1);
+        for (size_t i = 1; i < n; ++i) {
+            double h0 = knots[i] - knots[i - 1];
+            double h1 = knots[i + 1] - knots[i];
+            diag[i] = 2. * (h0 + h1);
+            rhs[i] = 6. * ((densities[i + 1] - densities[i]) / h1
+                         - (densities[i] - densities[i - 1]) / h0);
+        }
+        // Forward elimination
+        for (size_t i = 2; i < n; ++i) {
+            double h0 = knots[i] - knots[i - 1];
+            double factor = h0 / diag[i - 1];
+            diag[i] -= factor * h0;
+            rhs[i] -= factor * rhs[i - 1];
+        }
+        // Back substitution
+        for (size_t i = n - 1; i >= 1; --i) {
+            double h1 = knots[i + 1] - knots[i];
+            m2[i] = (rhs[i] - h1 * m2[i + 1]) / diag[i];
+        }
+    }
+
+    coeff_a.assign(densities.begin(), densities.end() - 1);
+    coeff_b.resize(n);
+    coeff_c.resize(n);
+    coeff_d.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        double h = knots[i + 1] - knots[i];
+        coeff_b[i] = (densities[i + 1] - densities[i]) / h
+                   - h * (2. * m2[i] + m2[i + 1]) / 6.;
+        coeff_c[i] = 0.5 * m2[i];
+        coeff_d[i] = (m2[i + 1] - m2[i]) / (6. * h);
+    }
+}
+
+/**
+ * Computes Fritsch-Carlson knot slopes: the weighted harmonic mean of the
+ * neighbouring secants inside, zero at local extrema, and a shape-preserving
+ * three-point estimate at both ends. The resulting interpolant never
+ * overshoots the data, so densities stay non-negative.
+ */
+std::vector<double> MomentumInterpolator::PchipSlopes(
+    const std::vector<double>& densities) const
+{
+    size_t n = knots.size() - 1;
+    std::vector<double> h(n), delta(n), slopes(n + 1, 0.);
+    for (size_t i = 0; i < n; ++i) {
+        h[i] = knots[i + 1] - knots[i];
+        delta[i] = (densities[i + 1] - densities[i]) / h[i];
+    }
+
+    if (n == 1) {
+        slopes[0] = slopes[1] = delta[0];
+        return slopes;
+    }
+
+    for (size_t i = 1; i < n; ++i) {
+        if (delta[i - 1] * delta[i] > 0.) {
+            double w1 = 2. * h[i] + h[i - 1];
+            double w2 = h[i] + 2. * h[i - 1];
+            slopes[i] = (w1 + w2) / (w1 / delta[i - 1] + w2 / delta[i]);
+        }
+    }
+
+    // One-sided three-point estimate at the ends, limited to preserve shape
+    auto end_slope = [](double h0, double h1, double del0, double del1) {
+        double slope = ((2. * h0 + h1) * del0 - h0 * del1) / (h0 + h1);
+        if (slope * del0 <= 0.) {
+            return 0.;
+        }
+        if (del0 * del1 < 0. && std::abs(slope) > std::abs(3. * del0)) {
+            return 3. * del0;
+        }
+        return slope;
+    };
+    slopes[0] = end_slope(h[0], h[1], delta[0], delta[1]);
+    slopes[n] = end_slope(h[n - 1], h[n - 2], delta[n - 1], delta[n - 2]);
+
+    return slopes;
+}
+
+/**
+ * Marks the grid as uniform if every knot lies within a small fraction of
+ * the average step from its equidistant position. Tables written with a
+ * fixed number of decimals (or converted from fm^-1) still qualify.
+ */
+void MomentumInterpolator::DetectUniformGrid()
+{
+    size_t n = knots.size() - 1;
+    double step = (knots.back() - knots.front()) / n;
+    double tolerance = UNIFORM_GRID_TOLERANCE * step;
+
+    is_uniform = true;
+    for (size_t i = 1; i < n; ++i) {
+        if (std::abs(knots[i] - (knots.front() + i * step)) > tolerance) {
+            is_uniform = false;
+            break;
+        }
+    }
+    inv_step = 1. / step;
+}
+
+/**
+ * Locates the segment containing the momentum. Uniform grids compute the
+ * index directly; other grids use a binary search whose loop body compiles
+ * to a conditional move instead of a branch.
+ */
+std::size_t MomentumInterpolator::FindSegment(double momentum) const
+{
+    size_t last = knots.size() - 2;
+    if (is_uniform) {
+        double position = (momentum - knots.front()) * inv_step;
+        size_t index = position > 0. ? static_cast<size_t>(position) : 0;
+        return std::min(index, last);
+    }
+
+    const double* base = knots.data();
+    size_t count = last + 1;
+    while (count > 1) {
+        size_t half = count / 2;
+        base = (base[half] <= momentum) ? base + half : base;
+        count -= half;
+    }
+    return static_cast<size_t>(base - knots.data());
+}
+
+/**
+ * Evaluates the interpolated distribution at a single momentum.
+ */
+double MomentumInterpolator::Evaluate(double momentum) const
+{
+    if (!IsValid() || !(momentum >= knots.front() && momentum <= knots.back())) {
+        return 0.;
+    }
+    size_t i = FindSegment(momentum);
+    double t = momentum - knots[i];
+    return coeff_a[i] + t * (coeff_b[i] + t * (coeff_c[i] + t * coeff_d[i]));
+}
+
+/**
+ * Evaluates the interpolated distribution for a batch of momenta. Points
+ * outside the table are clamped to the nearest segment and masked to zero
+ * afterwards, so the loop body carries no data-dependent branches.
+ */
+void MomentumInterpolator::Evaluate(
+    const double* momenta, double* densities, std::size_t count) const
+{
+    if (!IsValid()) {
+        std::fill(densities, densities + count, 0.);
+        return;
+    }
+
+    const double p_min = knots.front();
+    const double p_max = knots.back();
+    const double* a = coeff_a.data();
+    const double* b = coeff_b.data();
+    const double* c = coeff_c.data();
+    const double* d = coeff_d.data();
+    const double* x = knots.data();
+
+    for (size_t j = 0; j < count; ++j) {
+        double p = momenta[j];
+        double clamped = std::min(std::max(p, p_min), p_max);
+        size_t i = FindSegment(clamped);
+        double t = clamped - x[i];
+        double value = a[i] + t * (b[i] + t * (c[i] + t * d[i]));
+        densities[j] = (p >= p_min && p <= p_max) ? value : 0.;
+    }
+}
+
+std::vector<double> MomentumInterpolator::Evaluate(
+    const std::vector<double>& momenta) const
+{
+    std::vector<double> densities(momenta.size());
+    Evaluate(momenta.data(), densities.data(), momenta.size());
+    return densities;
+}
+
+/**
+ * Evaluates the interpolated distribution for ascending momenta by advancing
+ * the segment index monotonically, which avoids a search per point when a
+ * table is resampled onto another grid.
+ */
+void MomentumInterpolator::EvaluateSorted(
+    const double* momenta, double* densities, std::size_t count) const
+{
+    if (!IsValid()) {
+        std::fill(densities, densities + count, 0.);
+        return;
+    }
+
+    const double p_min = knots.front();
+    const double p_max = knots.back();
+    const size_t last = knots.size() - 2;
+    size_t i = 0;
+
+    for (size_t j = 0; j < count; ++j) {
+        double p = momenta[j];
+        if (!(p >= p_min && p <= p_max)) {
+            densities[j] = 0.;
+            continue;
+        }
+        while (i < last && knots[i + 1] <= p) {
+            ++i;
+        }
+        double t = p - knots[i];
+        densities[j] = coeff_a[i] + t * (coeff_b[i] + t * (coeff_c[i] + t * coeff_d[i]));
+    }
+}
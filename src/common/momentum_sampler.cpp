@@ -0,0 +1,186 @@
+/**
+ * @file momentum_sampler.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the MomentumSampler class for drawing momenta
+ *        from a tabulated distribution.
+ *
+ * @details
+ * Within a segment of width h with end densities f0 and f1 the density is
+ * f(t) = f0 + s t with s = (f1 - f0) / h, and the integral from the segment
+ * start is F(t) = f0 t + s t^2 / 2. For a remaining probability mass r the
+ * root t = 2 r / (f0 + sqrt(f0^2 + 2 s r)) is used, which is free of
+ * cancellation for rising and falling segments and reduces to r / f0 for flat
+ * ones. The segment itself is found from a guide table: the probability range
+ * is split into as many equal buckets as there are segments, each bucket
+ * stores the segment of its lower edge, and a short forward scan from there
+ * reaches the segment of the target. Grids are treated as equidistant when
+ * every knot lies within 1e-9 steps of its ideal position.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/momentum_sampler.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+MomentumSampler::MomentumSampler(
+    const std::vector<double>& momenta, const std::vector<double>& densities)
+{
+    Build(momenta.data(), densities.data(), std::min(momenta.size(), densities.size()));
+}
+
+bool MomentumSampler::Build(
+    const double* momenta, const double* densities, std::size_t count)
+{
+    knots.clear();
+    this->densities.clear();
+    cumulative.clear();
+    guide.clear();
+    norm = 0.;
+    inverse_step = 0.;
+
+    if (count < 2) {
+        std::cerr << "Error: At least two points are needed to sample a distribution."
+                  << std::endl;
+        return false;
+    }
+    for (std::size_t i = 1; i < count; ++i) {
+        if (!(momenta[i] > momenta[i - 1])) {
+            std::cerr << "Error: Momenta must be strictly increasing for sampling."
+                      << std::endl;
+            return false;
+        }
+    }
+
+    knots.assign(momenta, momenta + count);
+    this->densities.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        this->densities[i] = std::max(0., densities[i]);
+    }
+
+    // Trapezoidal integral, exact for the piecewise linear density
+    cumulative.resize(count);
+    cumulative[0] = 0.;
+    for (std::size_t i = 1; i < count; ++i) {
+        double h = knots[i] - knots[i - 1];
+        cumulative[i] = cumulative[i - 1] + 0.5 * h * (this->densities[i - 1] + this->densities[i]);
+    }
+    norm = cumulative.back();
+    if (!(norm > 0.)) {
+        std::cerr << "Error: The distribution to sample has no positive probability."
+                  << std::endl;
+        knots.clear();
+        this->densities.clear();
+        cumulative.clear();
+        norm = 0.;
+        return false;
+    }
+
+    double step = (knots.back() - knots.front()) / double(count - 1);
+    bool equidistant = true;
+    for (std::size_t i = 1; equidistant && i < count; ++i) {
+        equidistant = std::fabs(knots[i] - (knots.front() + double(i) * step)) <= 1e-9 * step;
+    }
+    inverse_step = equidistant ? 1. / step : 0.;
+
+    std::size_t segments = count - 1;
+    guide.resize(segments);
+    for (std::size_t j = 0, i = 0; j < segments; ++j) {
+        double target = norm * double(j) / double(segments);
+        while (i + 1 < segments && cumulative[i + 1] <= target) {++i;}
+        guide[j] = i;
+    }
+    return true;
+}
+
+std::size_t MomentumSampler::MomentumSegment(double momentum) const
+{
+    std::size_t last = knots.size() - 2;
+    if (inverse_step > 0.) {
+        double position = (momentum - knots.front()) * inverse_step;
+        return position > 0. ? std::min(std::size_t(position), last) : 0;
+    }
+    std::size_t i = std::upper_bound(knots.begin(), knots.end(), momentum) - knots.begin();
+    return std::min(std::max<std::size_t>(i, 1) - 1, last);
+}
+
+double MomentumSampler::Density(double momentum) const
+{
+    if (!IsValid() || momentum < knots.front() || momentum > knots.back()) {
+        return 0.;
+    }
+    std::size_t i = MomentumSegment(momentum);
+    double t = (momentum - knots[i]) / (knots[i + 1] - knots[i]);
+    return ((1. - t) * densities[i] + t * densities[i + 1]) / norm;
+}
+
+double MomentumSampler::Cdf(double momentum) const
+{
+    if (!IsValid() || momentum <= knots.front()) {
+        return 0.;
+    }
+    if (momentum >= knots.back()) {
+        return 1.;
+    }
+    std::size_t i = MomentumSegment(momentum);
+    double h = knots[i + 1] - knots[i];
+    double t = momentum - knots[i];
+    double slope = (densities[i + 1] - densities[i]) / h;
+    return (cumulative[i] + densities[i] * t + 0.5 * slope * t * t) / norm;
+}
+
+std::size_t MomentumSampler::FindSegment(double target) const
+{
+    // Last segment starting at or below the target, searched forward from the guide
+    std::size_t segments = knots.size() - 1;
+    std::size_t bucket = std::min(std::size_t(target / norm * double(segments)), segments - 1);
+    std::size_t i = guide[bucket];
+    while (i + 1 < segments && cumulative[i + 1] <= target) {++i;}
+    return i;
+}
+
+double MomentumSampler::Quantile(double probability) const
+{
+    if (!IsValid()) {
+        return 0.;
+    }
+    probability = std::min(std::max(probability, 0.), 1.);
+    double target = probability * norm;
+    std::size_t i = FindSegment(target);
+
+    double h = knots[i + 1] - knots[i];
+    double f0 = densities[i];
+    double slope = (densities[i + 1] - f0) / h;
+    double remaining = target - cumulative[i];
+    double discriminant = std::max(0., f0 * f0 + 2. * slope * remaining);
+    double denominator = f0 + std::sqrt(discriminant);
+    double t = denominator > 0. ? 2. * remaining / denominator : 0.;
+    return knots[i] + std::min(std::max(t, 0.), h);
+}
+
+double MomentumSampler::Sample(std::mt19937_64& engine) const
+{
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    return Quantile(uniform(engine));
+}
+
+void MomentumSampler::Sample(
+    std::mt19937_64& engine, double* momenta, std::size_t count) const
+{
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    for (std::size_t i = 0; i < count; ++i) {
+        momenta[i] = Quantile(uniform(engine));
+    }
+}
+
+std::vector<double> MomentumSampler::Sample(std::uint64_t seed, std::size_t count) const
+{
+    std::mt19937_64 engine(seed);
+    std::vector<double> momenta(count);
+    Sample(engine, momenta.data(), count);
+    return momenta;
+}
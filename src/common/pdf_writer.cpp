@@ -0,0 +1,144 @@
+/**
+ * @file pdf_writer.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the PdfWriter class, a streaming multi-page PDF writer.
+ *
+ * @details
+ * Object 1 is the catalog, object 2 the page tree and object 3 the Helvetica
+ * font; every page adds its content stream and its page object. Content
+ * streams are compressed with the deflate encoder of PngWriter (FlateDecode).
+ * The catalog and the page tree are written last, once all page objects are
+ * known, followed by the cross-reference table of all object offsets.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/pdf_writer.h"
+#include "../include/common/png_writer.h"
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+const int CATALOG_OBJECT = 1;
+const int PAGES_OBJECT = 2;
+const int FONT_OBJECT = 3;
+
+// Helvetica glyph widths of the characters 32-126, in 1/1000 of the font size
+static const short HELVETICA_WIDTHS[95] = {
+    278, 278, 355, 556, 556, 889, 667, 191, 333, 333, 389, 584, 278, 333, 278, 278,
+    556, 556, 556, 556, 556, 556, 556, 556, 556, 556, 278, 278, 584, 584, 584, 556,
+    1015, 667, 667, 722, 722, 667, 611, 778, 722, 278, 500, 667, 556, 833, 722, 778,
+    667, 778, 722, 667, 611, 722, 667, 944, 667, 667, 611, 278, 278, 278, 469, 556,
+    333, 556, 556, 500, 556, 556, 278, 556, 556, 222, 222, 500, 222, 833, 556, 556,
+    556, 556, 333, 500, 278, 556, 500, 722, 500, 500, 500, 334, 260, 334, 584
+};
+
+PdfWriter::~PdfWriter()
+{
+    if (IsOpen()) {
+        Close();
+    }
+}
+
+double PdfWriter::TextWidth(const std::string& text)
+{
+    double width = 0.;
+    for (char c : text) {
+        int code = static_cast<unsigned char>(c);
+        width += (code >= 32 && code < 127) ? HELVETICA_WIDTHS[code - 32] : 556;
+    }
+    return width / 1000.;
+}
+
+void PdfWriter::BeginObject(int number)
+{
+    if (offsets.size() < std::size_t(number)) {
+        offsets.resize(number, 0);
+    }
+    offsets[number - 1] = std::size_t(file.tellp());
+    file << number << " 0 obj\n";
+}
+
+bool PdfWriter::Open(const std::string& file_path)
+{
+    if (IsOpen()) {
+        Close();
+    }
+    file.open(file_path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open output file: " << file_path << std::endl;
+        return false;
+    }
+    path = file_path;
+    offsets.assign(FONT_OBJECT, 0);
+    pages.clear();
+
+    // The comment with high-bit characters marks the file as binary
+    file << "%PDF-1.4\n%\xE2\xE3\xCF\xD3\n";
+    BeginObject(FONT_OBJECT);
+    file << "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica"
+         << " /Encoding /WinAnsiEncoding >>\nendobj\n";
+    return bool(file);
+}
+
+bool PdfWriter::AddPage(double width, double height, const std::string& content)
+{
+    if (!IsOpen()) {
+        std::cerr << "Error: No PDF document is open." << std::endl;
+        return false;
+    }
+
+    std::vector<std::uint8_t> compressed =
+        PngWriter::Compress(std::vector<std::uint8_t>(content.begin(), content.end()));
+    const int content_object = int(offsets.size()) + 1;
+    const int page_object = content_object + 1;
+
+    BeginObject(content_object);
+    file << "<< /Length " << compressed.size() << " /Filter /FlateDecode >>\nstream\n";
+    file.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+    file << "\nendstream\nendobj\n";
+
+    BeginObject(page_object);
+    file << "<< /Type /Page /Parent " << PAGES_OBJECT << " 0 R /MediaBox [0 0 "
+         << width << ' ' << height << "] /Resources << /Font << /F1 " << FONT_OBJECT
+         << " 0 R >> >> /Contents " << content_object << " 0 R >>\nendobj\n";
+    pages.push_back(page_object);
+    return bool(file);
+}
+
+bool PdfWriter::Close()
+{
+    if (!IsOpen()) {
+        return false;
+    }
+
+    BeginObject(PAGES_OBJECT);
+    file << "<< /Type /Pages /Count " << pages.size() << " /Kids [";
+    for (int page : pages) {
+        file << ' ' << page << " 0 R";
+    }
+    file << " ] >>\nendobj\n";
+    BeginObject(CATALOG_OBJECT);
+    file << "<< /Type /Catalog /Pages " << PAGES_OBJECT << " 0 R >>\nendobj\n";
+
+    // Cross-reference table: fixed 20-byte entries, object 0 heads the free list
+    const std::size_t xref_offset = std::size_t(file.tellp());
+    file << "xref\n0 " << offsets.size() + 1 << "\n0000000000 65535 f \n";
+    char entry[24];
+    for (std::size_t offset : offsets) {
+        std::snprintf(entry, sizeof(entry), "%010zu 00000 n \n", offset);
+        file << entry;
+    }
+    file << "trailer\n<< /Size " << offsets.size() + 1 << " /Root " << CATALOG_OBJECT
+         << " 0 R >>\nstartxref\n" << xref_offset << "\n%%EOF\n";
+
+    bool success = bool(file);
+    file.close();
+    if (!success) {
+        std::cerr << "Error: Failed to write the PDF document: " << path << std::endl;
+    }
+    return success;
+}
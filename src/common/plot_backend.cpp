@@ -0,0 +1,143 @@
+/**
+ * @file plot_backend.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Runtime selection of the plot backend.
+ *
+ * @details
+ * The backend is chosen by name, normally from the PLOT_BACKEND environment
+ * variable: "root" draws with ROOT graphics, "lite" with the built-in SVG/PNG
+ * renderer.
+ *
+ * The executables do not link against ROOT. The ROOT backend lives in the
+ * plugin libroot_plot_backend.so, which is opened with dlopen when the first
+ * plot is rendered, so runs that never plot do not load ROOT at all. The
+ * plugin is searched for at the path in PLOT_ROOT_PLUGIN, next to the
+ * executable and finally on the default library path. If it cannot be loaded,
+ * the lite backend takes over with a warning.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/plot_backend.h"
+#include "../include/common/lite_plot_backend.h"
+#include <cstdlib>
+#include <dlfcn.h>
+#include <iostream>
+#include <limits.h>
+#include <unistd.h>
+
+const char* ROOT_PLUGIN_NAME = "libroot_plot_backend.so";
+const char* ROOT_PLUGIN_ENTRY = "CreateRootPlotBackend";
+
+/**
+ * Directory of the running executable, with a trailing slash; empty if unknown.
+ */
+static std::string ExecutableDirectory()
+{
+    char path[PATH_MAX];
+    ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (length <= 0) {
+        return "";
+    }
+    std::string directory(path, length);
+    return directory.substr(0, directory.rfind('/') + 1);
+}
+
+/**
+ * Proxy for the ROOT backend that loads the plugin on the first plot or document.
+ * The library is never closed: ROOT does not support being unloaded, and the
+ * backend object must not outlive its code.
+ */
+class RootPluginBackend : public PlotBackend {
+public:
+    bool Render(const PlotSpec& spec, const std::string& output_path) override
+    {
+        return Active().Render(spec, output_path);
+    }
+
+    bool OpenDocument(const std::string& output_path) override
+    {
+        return Active().OpenDocument(output_path);
+    }
+
+    bool AddPage(const PlotSpec& spec) override { return Active().AddPage(spec); }
+
+    bool CloseDocument() override { return Active().CloseDocument(); }
+
+    /**
+     * The backend that actually draws: "root", or "lite" if the plugin is
+     * missing. Image fingerprints include the name, so a fallback image is
+     * redrawn once the plugin becomes available.
+     */
+    const char* Name() const override { return Active().Name(); }
+
+private:
+    PlotBackend& Active() const
+    {
+        if (!loaded) {
+            Load();
+        }
+        return backend ? *backend : static_cast<PlotBackend&>(fallback);
+    }
+
+    void Load() const
+    {
+        loaded = true;
+        std::vector<std::string> candidates;
+        const char* configured = std::getenv("PLOT_ROOT_PLUGIN");
+        if (configured != nullptr && *configured != '\0') {
+            candidates.push_back(configured);
+        }
+        std::string directory = ExecutableDirectory();
+        if (!directory.empty()) {
+            candidates.push_back(directory + ROOT_PLUGIN_NAME);
+        }
+        candidates.push_back(ROOT_PLUGIN_NAME);
+
+        void* handle = nullptr;
+        for (const std::string& candidate : candidates) {
+            handle = dlopen(candidate.c_str(), RTLD_NOW | RTLD_GLOBAL);
+            if (handle != nullptr) {break;}
+        }
+        if (handle == nullptr) {
+            std::cerr << "Warning: ROOT plot plugin not available (" << dlerror()
+                      << "), using the lite backend." << std::endl;
+            return;
+        }
+
+        using Factory = PlotBackend* (*)();
+        auto factory = reinterpret_cast<Factory>(dlsym(handle, ROOT_PLUGIN_ENTRY));
+        if (factory == nullptr) {
+            std::cerr << "Warning: " << ROOT_PLUGIN_NAME << " has no entry point "
+                      << ROOT_PLUGIN_ENTRY << ", using the lite backend." << std::endl;
+            return;
+        }
+        backend.reset(factory());
+    }
+
+    // Resolved on first use, which may be a call of the const Name()
+    mutable bool loaded = false;
+    mutable std::unique_ptr<PlotBackend> backend;
+    mutable LitePlotBackend fallback;
+};
+
+std::string DefaultPlotBackendName()
+{
+    const char* name = std::getenv("PLOT_BACKEND");
+    return (name != nullptr && *name != '\0') ? name : "root";
+}
+
+std::unique_ptr<PlotBackend> CreatePlotBackend(const std::string& name)
+{
+    if (name == "root") {
+        return std::make_unique<RootPluginBackend>();
+    }
+    if (name != "lite" && name != "svg" && name != "png") {
+        std::cerr << "Warning: Unknown plot backend '" << name
+                  << "', using the lite backend." << std::endl;
+    }
+    return std::make_unique<LitePlotBackend>();
+}
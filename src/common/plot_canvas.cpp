@@ -0,0 +1,51 @@
+/**
+ * @file plot_canvas.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the PlotCanvas class holding the pooled ROOT canvas.
+ *
+ * @details
+ * In batch mode ROOT renders into an off-screen buffer, so the cost of a plot
+ * is drawing the primitives and encoding the image. Reusing one canvas keeps
+ * the creation of the pad, its frame and its image buffer out of that cost.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/plot_canvas.h"
+#include "TCanvas.h"
+#include "TROOT.h"
+
+void PlotCanvas::EnableBatchMode()
+{
+    gROOT->SetBatch(kTRUE);
+}
+
+/**
+ * Creates the canvas on first use. Later calls check that ROOT still owns it
+ * (it is gone if it was closed), clear it and adapt its title and size.
+ */
+TCanvas* PlotCanvas::Acquire(const std::string& title, int width, int height)
+{
+    static TCanvas* canvas = nullptr;
+
+    if (canvas != nullptr
+        && gROOT->GetListOfCanvases()->FindObject(canvas) == nullptr) {
+        canvas = nullptr;
+    }
+
+    if (canvas == nullptr) {
+        canvas = new TCanvas("plot_canvas", title.c_str(), width, height);
+    } else {
+        canvas->Clear();
+        canvas->SetTitle(title.c_str());
+        if (canvas->GetWw() != UInt_t(width) || canvas->GetWh() != UInt_t(height)) {
+            canvas->SetCanvasSize(width, height);
+        }
+    }
+
+    canvas->cd();
+    return canvas;
+}
@@ -0,0 +1,286 @@
+/**
+ * @file png_writer.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the PngWriter class, a self-contained PNG encoder.
+ *
+ * @details
+ * A PNG file is the signature followed by the IHDR, IDAT and IEND chunks. The
+ * IDAT payload is a zlib stream of the filtered rows (filter type 0, so every
+ * row starts with a zero byte). The deflate encoder emits a single block with
+ * the fixed Huffman code of RFC 1951; repeated byte sequences are replaced by
+ * (length, distance) pairs found through a hash of the next three bytes. Long
+ * runs of background pixels therefore shrink to a few bits per 258 bytes.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/png_writer.h"
+#include <array>
+#include <fstream>
+#include <iostream>
+
+const std::size_t WINDOW_SIZE = 32768;  // Deflate window
+const std::size_t MIN_MATCH = 3;        // Shortest deflate match
+const std::size_t MAX_MATCH = 258;      // Longest deflate match
+const int HASH_BITS = 15;               // Size of the match hash table
+
+// Deflate length and distance code tables (RFC 1951, section 3.2.5)
+static const int LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const int LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const int DISTANCE_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const int DISTANCE_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/**
+ * Writes bits least significant bit first, as deflate requires.
+ */
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<std::uint8_t>& output) : output(output) {}
+
+    void Write(std::uint32_t value, int count) {
+        for (int i = 0; i < count; ++i) {
+            buffer |= ((value >> i) & 1u) << filled;
+            if (++filled == 8) {
+                output.push_back(std::uint8_t(buffer));
+                buffer = 0;
+                filled = 0;
+            }
+        }
+    }
+
+    // Huffman codes are stored most significant bit first
+    void WriteCode(std::uint32_t code, int length) {
+        for (int i = length - 1; i >= 0; --i) {
+            Write((code >> i) & 1u, 1);
+        }
+    }
+
+    void Flush() {
+        if (filled > 0) {
+            output.push_back(std::uint8_t(buffer));
+            buffer = 0;
+            filled = 0;
+        }
+    }
+
+private:
+    std::vector<std::uint8_t>& output;
+    std::uint32_t buffer = 0;
+    int filled = 0;
+};
+
+/**
+ * Emits a literal/length symbol with the fixed Huffman code.
+ */
+static void WriteLiteralLength(BitWriter& bits, int symbol)
+{
+    if (symbol < 144) {
+        bits.WriteCode(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        bits.WriteCode(0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        bits.WriteCode(symbol - 256, 7);
+    } else {
+        bits.WriteCode(0xC0 + symbol - 280, 8);
+    }
+}
+
+static void WriteMatch(BitWriter& bits, std::size_t length, std::size_t distance)
+{
+    int code = 28;
+    while (LENGTH_BASE[code] > int(length)) {
+        --code;
+    }
+    WriteLiteralLength(bits, 257 + code);
+    bits.Write(std::uint32_t(length - LENGTH_BASE[code]), LENGTH_EXTRA[code]);
+
+    code = 29;
+    while (DISTANCE_BASE[code] > int(distance)) {
+        --code;
+    }
+    bits.WriteCode(code, 5);
+    bits.Write(std::uint32_t(distance - DISTANCE_BASE[code]), DISTANCE_EXTRA[code]);
+}
+
+std::uint32_t PngWriter::Crc32(
+    const std::uint8_t* data, std::size_t size, std::uint32_t crc)
+{
+    // Built once on first use; the initialisation of a local static is
+    // thread-safe, so PNGs may be written from several threads
+    static const std::array<std::uint32_t, 256> table = []() {
+        std::array<std::uint32_t, 256> entries{};
+        for (std::uint32_t n = 0; n < 256; ++n) {
+            std::uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[n] = c;
+        }
+        return entries;
+    }();
+
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+std::uint32_t PngWriter::Adler32(const std::uint8_t* data, std::size_t size)
+{
+    const std::uint32_t modulus = 65521;
+    std::uint32_t a = 1, b = 0;
+    while (size > 0) {
+        // 5552 is the largest block for which b cannot overflow
+        std::size_t block = size < 5552 ? size : 5552;
+        size -= block;
+        while (block-- > 0) {
+            a += *data++;
+            b += a;
+        }
+        a %= modulus;
+        b %= modulus;
+    }
+    return (b << 16) | a;
+}
+
+/**
+ * Greedy LZ77 over a hash of three bytes, remembering the latest position of
+ * each hash, followed by the fixed-Huffman encoding of one final block.
+ */
+std::vector<std::uint8_t> PngWriter::Compress(const std::vector<std::uint8_t>& data)
+{
+    std::vector<std::uint8_t> output = {0x78, 0x01};  // zlib header, 32K window
+    BitWriter bits(output);
+    bits.Write(1, 1);   // Final block
+    bits.Write(1, 2);   // Fixed Huffman codes
+
+    const std::size_t size = data.size();
+    std::vector<std::size_t> head(std::size_t(1) << HASH_BITS, std::size_t(-1));
+    auto hash = [&data](std::size_t i) {
+        std::uint32_t h = (std::uint32_t(data[i]) << 16)
+                        | (std::uint32_t(data[i + 1]) << 8) | data[i + 2];
+        return (h * 2654435761u) >> (32 - HASH_BITS);
+    };
+
+    std::size_t i = 0;
+    while (i < size) {
+        std::size_t best_length = 0, best_distance = 0;
+        if (i + MIN_MATCH <= size) {
+            std::uint32_t h = hash(i);
+            std::size_t candidate = head[h];
+            head[h] = i;
+            if (candidate != std::size_t(-1) && i - candidate <= WINDOW_SIZE) {
+                std::size_t limit = size - i < MAX_MATCH ? size - i : MAX_MATCH;
+                std::size_t length = 0;
+                while (length < limit && data[candidate + length] == data[i + length]) {
+                    ++length;
+                }
+                if (length >= MIN_MATCH) {
+                    best_length = length;
+                    best_distance = i - candidate;
+                }
+            }
+        }
+
+        if (best_length > 0) {
+            WriteMatch(bits, best_length, best_distance);
+            // Register the skipped positions so later matches can refer to them
+            for (std::size_t j = i + 1; j < i + best_length && j + MIN_MATCH <= size; ++j) {
+                head[hash(j)] = j;
+            }
+            i += best_length;
+        } else {
+            WriteLiteralLength(bits, data[i]);
+            ++i;
+        }
+    }
+
+    WriteLiteralLength(bits, 256);  // End of block
+    bits.Flush();
+
+    std::uint32_t adler = Adler32(data.data(), size);
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        output.push_back(std::uint8_t(adler >> shift));
+    }
+    return output;
+}
+
+/**
+ * Appends a chunk (length, type, data, CRC of type and data) to the file.
+ */
+static void WriteChunk(
+    std::ofstream& file, const char* type, const std::vector<std::uint8_t>& data)
+{
+    std::vector<std::uint8_t> block;
+    block.reserve(data.size() + 12);
+    std::uint32_t length = std::uint32_t(data.size());
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        block.push_back(std::uint8_t(length >> shift));
+    }
+    block.insert(block.end(), type, type + 4);
+    block.insert(block.end(), data.begin(), data.end());
+    std::uint32_t crc = PngWriter::Crc32(block.data() + 4, data.size() + 4);
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        block.push_back(std::uint8_t(crc >> shift));
+    }
+    file.write(reinterpret_cast<const char*>(block.data()), block.size());
+}
+
+bool PngWriter::Write(
+    const std::string& file_path, int width, int height,
+    const std::vector<std::uint8_t>& rgb)
+{
+    const std::size_t stride = std::size_t(width) * 3;
+    if (width <= 0 || height <= 0 || rgb.size() < stride * height) {
+        std::cerr << "Error: Invalid image size for PNG output: " << file_path
+                  << std::endl;
+        return false;
+    }
+
+    std::ofstream file(file_path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open output file: " << file_path << std::endl;
+        return false;
+    }
+
+    static const std::uint8_t signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+    file.write(reinterpret_cast<const char*>(signature), 8);
+
+    std::vector<std::uint8_t> header;
+    for (std::uint32_t value : {std::uint32_t(width), std::uint32_t(height)}) {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            header.push_back(std::uint8_t(value >> shift));
+        }
+    }
+    // Bit depth 8, colour type 2 (RGB), deflate, adaptive filtering, no interlace
+    header.insert(header.end(), {8, 2, 0, 0, 0});
+    WriteChunk(file, "IHDR", header);
+
+    std::vector<std::uint8_t> rows;
+    rows.reserve((stride + 1) * height);
+    for (int row = 0; row < height; ++row) {
+        rows.push_back(0);  // Filter type None
+        rows.insert(rows.end(), rgb.begin() + row * stride,
+                    rgb.begin() + (row + 1) * stride);
+    }
+    WriteChunk(file, "IDAT", Compress(rows));
+    WriteChunk(file, "IEND", {});
+
+    return bool(file);
+}
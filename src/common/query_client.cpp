@@ -0,0 +1,158 @@
+/**
+ * @file query_client.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the QueryClient class for querying a QueryServer.
+ *
+ * @details
+ * The request header and its payload leave in one sendmsg call, and the
+ * answer is read straight into the caller's output buffer. A failed transfer
+ * closes the connection, because the position in the stream is then unknown.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/query_client.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+QueryClient::~QueryClient()
+{
+    Disconnect();
+}
+
+bool QueryClient::Connect(const std::string& socket_path)
+{
+    Disconnect();
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Invalid socket path: " << socket_path << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (descriptor < 0 || connect(descriptor, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "Error: Could not connect to " << socket_path << ": " << std::strerror(errno) << std::endl;
+        Disconnect();
+        return false;
+    }
+    return true;
+}
+
+void QueryClient::Disconnect()
+{
+    if (descriptor >= 0) {
+        close(descriptor);
+        descriptor = -1;
+    }
+}
+
+bool QueryClient::Evaluate(const std::string& model, const double* momenta, double* densities, std::size_t count)
+{
+    return Query(QUERY_EVALUATE, model, momenta, densities, count, 0);
+}
+
+bool QueryClient::Cdf(const std::string& model, const double* momenta, double* probabilities, std::size_t count)
+{
+    return Query(QUERY_CDF, model, momenta, probabilities, count, 0);
+}
+
+bool QueryClient::Quantile(const std::string& model, const double* probabilities, double* momenta, std::size_t count)
+{
+    return Query(QUERY_QUANTILE, model, probabilities, momenta, count, 0);
+}
+
+bool QueryClient::Sample(const std::string& model, std::uint64_t seed, double* momenta, std::size_t count)
+{
+    return Query(QUERY_SAMPLE, model, nullptr, momenta, count, seed);
+}
+
+bool QueryClient::Query(
+    QueryOperation operation, const std::string& model, const double* input,
+    double* output, std::size_t count, std::uint64_t seed)
+{
+    if (descriptor < 0) {
+        std::cerr << "Error: The query client is not connected." << std::endl;
+        return false;
+    }
+    if (model.size() > QUERY_MODEL_NAME_SIZE || count > QUERY_MAX_POINTS) {
+        last_status = model.size() > QUERY_MODEL_NAME_SIZE ? QUERY_UNKNOWN_MODEL : QUERY_TOO_LARGE;
+        return false;
+    }
+
+    QueryRequest request = {};
+    request.magic = QUERY_MAGIC;
+    request.operation = operation;
+    std::memcpy(request.model, model.data(), model.size());
+    request.count = count;
+    request.seed = seed;
+
+    iovec parts[2] = {
+        {&request, sizeof(request)},
+        {const_cast<double*>(input), input != nullptr ? count * sizeof(double) : 0},
+    };
+    msghdr message = {};
+    message.msg_iov = parts;
+    message.msg_iovlen = input != nullptr && count > 0 ? 2 : 1;
+    while (message.msg_iovlen > 0) {
+        ssize_t sent = sendmsg(descriptor, &message, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {continue;}
+        if (sent <= 0) {
+            std::cerr << "Error: Sending a query failed: " << std::strerror(errno) << std::endl;
+            Disconnect();
+            return false;
+        }
+        std::size_t done = std::size_t(sent);
+        while (message.msg_iovlen > 0 && done >= message.msg_iov->iov_len) {
+            done -= message.msg_iov->iov_len;
+            ++message.msg_iov;
+            --message.msg_iovlen;
+        }
+        if (message.msg_iovlen > 0) {
+            message.msg_iov->iov_base = static_cast<char*>(message.msg_iov->iov_base) + done;
+            message.msg_iov->iov_len -= done;
+        }
+    }
+
+    // Header first, then the payload it announces
+    QueryResponse response;
+    char* position = reinterpret_cast<char*>(&response);
+    std::size_t remaining = sizeof(response);
+    for (int part = 0; part < 2; ++part) {
+        while (remaining > 0) {
+            ssize_t received = read(descriptor, position, remaining);
+            if (received < 0 && errno == EINTR) {continue;}
+            if (received <= 0) {
+                std::cerr << "Error: The query server closed the connection." << std::endl;
+                Disconnect();
+                return false;
+            }
+            position += received;
+            remaining -= std::size_t(received);
+        }
+        if (part == 0) {
+            if (response.magic != QUERY_MAGIC || (response.status == QUERY_OK && response.count != count)) {
+                std::cerr << "Error: Invalid response from the query server." << std::endl;
+                Disconnect();
+                return false;
+            }
+            last_status = QueryStatus(response.status);
+            last_version = response.version;
+            position = reinterpret_cast<char*>(output);
+            remaining = response.status == QUERY_OK ? count * sizeof(double) : 0;
+        }
+    }
+    if (last_status == QUERY_BAD_REQUEST || last_status == QUERY_TOO_LARGE) {
+        Disconnect(); // The server closes the connection after these
+    }
+    return last_status == QUERY_OK;
+}
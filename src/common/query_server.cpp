@@ -0,0 +1,214 @@
+/**
+ * @file query_server.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the QueryServer class answering distribution queries
+ *        over a Unix domain socket.
+ *
+ * @details
+ * The catalog is held in an immutable snapshot behind a shared pointer that is
+ * read and replaced with the atomic shared_ptr functions. A query takes its own
+ * reference to the snapshot, so publishing a new catalog never blocks a query
+ * and the old catalog is freed when its last query has finished.
+ *
+ * A request whose header cannot be trusted (wrong magic, unknown operation or
+ * too many points) is answered with an error and the connection is closed,
+ * because the start of the next request can no longer be found. An unknown
+ * model only fails the query itself.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/query_server.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * Reads exactly size bytes; false on end of stream or error.
+ */
+static bool ReadAll(int descriptor, void* data, std::size_t size)
+{
+    char* position = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t received = read(descriptor, position, size);
+        if (received < 0 && errno == EINTR) {continue;}
+        if (received <= 0) {return false;}
+        position += received;
+        size -= std::size_t(received);
+    }
+    return true;
+}
+
+/**
+ * Sends the response header and payload with as few system calls as possible.
+ */
+static bool SendResponse(int descriptor, const QueryResponse& response, const double* values)
+{
+    iovec parts[2] = {
+        {const_cast<QueryResponse*>(&response), sizeof(response)},
+        {const_cast<double*>(values), std::size_t(response.count) * sizeof(double)},
+    };
+    msghdr message = {};
+    message.msg_iov = parts;
+    message.msg_iovlen = response.count > 0 ? 2 : 1;
+    while (message.msg_iovlen > 0) {
+        ssize_t sent = sendmsg(descriptor, &message, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {continue;}
+        if (sent <= 0) {return false;}
+        // Skip what was sent after a partial write
+        std::size_t done = std::size_t(sent);
+        while (message.msg_iovlen > 0 && done >= message.msg_iov->iov_len) {
+            done -= message.msg_iov->iov_len;
+            ++message.msg_iov;
+            --message.msg_iovlen;
+        }
+        if (message.msg_iovlen > 0) {
+            message.msg_iov->iov_base = static_cast<char*>(message.msg_iov->iov_base) + done;
+            message.msg_iov->iov_len -= done;
+        }
+    }
+    return true;
+}
+
+QueryServer::~QueryServer()
+{
+    if (listen_descriptor >= 0) {
+        close(listen_descriptor);
+        unlink(path.c_str());
+    }
+}
+
+void QueryServer::Publish(Catalog catalog)
+{
+    std::shared_ptr<const Snapshot> previous = std::atomic_load(&current);
+    std::uint64_t next_version = previous ? previous->version + 1 : 1;
+    std::atomic_store(&current, std::shared_ptr<const Snapshot>(
+        new Snapshot{std::move(catalog), next_version}));
+}
+
+std::uint64_t QueryServer::Version() const
+{
+    std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&current);
+    return snapshot ? snapshot->version : 0;
+}
+
+bool QueryServer::Listen(const std::string& socket_path)
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Invalid socket path: " << socket_path << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    int descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (descriptor < 0) {
+        std::cerr << "Error: Could not create the server socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    unlink(socket_path.c_str()); // Left behind by a server that was killed
+    if (bind(descriptor, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || listen(descriptor, SOMAXCONN) != 0) {
+        std::cerr << "Error: Could not listen on " << socket_path << ": " << std::strerror(errno) << std::endl;
+        close(descriptor);
+        return false;
+    }
+    listen_descriptor = descriptor;
+    path = socket_path;
+    return true;
+}
+
+bool QueryServer::Run()
+{
+    if (listen_descriptor < 0) {
+        return false;
+    }
+    for (;;) {
+        int descriptor = accept4(listen_descriptor, nullptr, nullptr, SOCK_CLOEXEC);
+        if (descriptor < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {continue;}
+            std::cerr << "Error: Accepting a connection failed: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        std::thread(&QueryServer::ServeConnection, this, descriptor).detach();
+    }
+}
+
+void QueryServer::ServeConnection(int descriptor)
+{
+    std::vector<double> values;     // Reused for all queries of the connection
+    QueryRequest request;
+    while (ReadAll(descriptor, &request, sizeof(request))) {
+        QueryResponse response = {QUERY_MAGIC, QUERY_OK, 0, 0};
+        bool has_input = request.operation == QUERY_EVALUATE || request.operation == QUERY_CDF
+                      || request.operation == QUERY_QUANTILE;
+        if (request.magic != QUERY_MAGIC || (!has_input && request.operation != QUERY_SAMPLE)) {
+            response.status = QUERY_BAD_REQUEST;
+            SendResponse(descriptor, response, nullptr);
+            break;
+        }
+        if (request.count > QUERY_MAX_POINTS) {
+            response.status = QUERY_TOO_LARGE;
+            SendResponse(descriptor, response, nullptr);
+            break;
+        }
+
+        values.resize(request.count);
+        if (has_input && !ReadAll(descriptor, values.data(), values.size() * sizeof(double))) {
+            break;
+        }
+        std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&current);
+        if (snapshot) {
+            response.status = Answer(request, values, snapshot->catalog);
+            response.version = snapshot->version;
+        } else {
+            response.status = QUERY_UNKNOWN_MODEL;
+        }
+        response.count = response.status == QUERY_OK ? values.size() : 0;
+        if (!SendResponse(descriptor, response, values.data())) {
+            break;
+        }
+    }
+    close(descriptor);
+}
+
+QueryStatus QueryServer::Answer(
+    const QueryRequest& request, std::vector<double>& values, const Catalog& catalog)
+{
+    std::string model_name(request.model, strnlen(request.model, sizeof(request.model)));
+    auto model = catalog.find(model_name);
+    if (model == catalog.end()) {
+        return QUERY_UNKNOWN_MODEL;
+    }
+    const MomentumSampler& sampler = model->second;
+
+    switch (request.operation) {
+    case QUERY_EVALUATE:
+        for (double& value : values) {value = sampler.Density(value);}
+        return QUERY_OK;
+    case QUERY_CDF:
+        for (double& value : values) {value = sampler.Cdf(value);}
+        return QUERY_OK;
+    case QUERY_QUANTILE:
+        for (double& value : values) {value = sampler.Quantile(value);}
+        return QUERY_OK;
+    case QUERY_SAMPLE: {
+        std::mt19937_64 engine(request.seed);
+        values.resize(request.count);
+        sampler.Sample(engine, values.data(), values.size());
+        return QUERY_OK;
+    }
+    default:
+        return QUERY_BAD_REQUEST;
+    }
+}
@@ -0,0 +1,491 @@
+/**
+ * @file render_farm.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the RenderFarm class for rendering plots in forked
+ *        worker processes.
+ *
+ * @details
+ * The anonymous MAP_SHARED mapping is laid out as
+ *
+ *   [SharedState][pending ring][free stack][job slots]
+ *
+ * A submitted job takes a slot index from the free stack, is copied into that
+ * slot and its index is appended to the pending ring. A worker takes the oldest
+ * pending index, renders straight from the slot and returns the index to the
+ * free stack. The short critical sections on the indices are guarded by a
+ * process-shared semaphore used as a mutex; two counting semaphores block the
+ * parent while no slot is free and the workers while no job is pending.
+ *
+ * Each slot is a RenderJob header followed by its points, and all slots have
+ * the size Start() derived from the densest series and the largest number of
+ * series per job. A job that is still too large for a slot, e.g. because a
+ * series came out denser than announced, is drawn by the parent instead, just
+ * like every job when no workers run.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/render_farm.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+const long SLOT_WAIT_MS = 200;  // Interval for checking on the workers while blocked
+
+struct RenderFarm::SharedState {
+    sem_t lock;                 // Guards the indices and counters below
+    sem_t free_slots;           // Number of free slots
+    sem_t pending_jobs;         // Number of pending jobs plus stop signals
+    std::size_t head;           // Next pending entry to render
+    std::size_t tail;           // Next pending entry to fill
+    std::size_t free_top;       // Number of entries on the free stack
+    int stopping;               // Set once no further jobs will arrive
+    std::size_t completed;      // Jobs rendered successfully
+    std::size_t failed;         // Jobs whose callback failed
+};
+
+/**
+ * Waits on a semaphore, retrying when interrupted by a signal.
+ */
+static void Wait(sem_t* semaphore)
+{
+    while (sem_wait(semaphore) != 0 && errno == EINTR) {}
+}
+
+/**
+ * Waits on a semaphore for at most the given number of milliseconds.
+ * Returns false on timeout.
+ */
+static bool WaitFor(sem_t* semaphore, long milliseconds)
+{
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += milliseconds / 1000;
+    deadline.tv_nsec += (milliseconds % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    while (sem_timedwait(semaphore, &deadline) != 0) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Copies a string into a fixed-size, null-terminated buffer.
+ * Returns false if the string does not fit.
+ */
+static bool CopyText(char* buffer, std::size_t capacity, const std::string& text)
+{
+    if (text.size() >= capacity) {
+        return false;
+    }
+    std::memcpy(buffer, text.c_str(), text.size() + 1);
+    return true;
+}
+
+RenderRequest RenderJob::Request() const
+{
+    RenderRequest request{kind, title, output_path, {}};
+    for (std::size_t i = 0; i < series_count; ++i) {
+        request.series.push_back(Series(i));
+    }
+    return request;
+}
+
+RenderFarm::RenderFarm(std::size_t workers, RenderCallback callback, std::size_t slots)
+    : requested_workers(workers),
+      slot_count(slots > 0 ? slots : std::max<std::size_t>(2 * workers, 1)),
+      callback(std::move(callback)) {}
+
+RenderFarm::~RenderFarm()
+{
+    Finish();
+}
+
+RenderFarm::SharedState* RenderFarm::State() const
+{
+    return static_cast<SharedState*>(mapping);
+}
+
+/**
+ * The pending ring and the free stack directly follow the shared state.
+ */
+std::size_t* RenderFarm::PendingRing() const
+{
+    return reinterpret_cast<std::size_t*>(State() + 1);
+}
+
+std::size_t* RenderFarm::FreeStack() const
+{
+    return PendingRing() + slot_count;
+}
+
+/**
+ * Rounds a byte count up to the alignment of RenderJob.
+ */
+static std::size_t AlignForJob(std::size_t bytes)
+{
+    return (bytes + alignof(RenderJob) - 1) / alignof(RenderJob) * alignof(RenderJob);
+}
+
+/**
+ * The slots follow the two index arrays, aligned for RenderJob.
+ */
+RenderJob* RenderFarm::Slot(std::size_t index) const
+{
+    std::size_t offset = AlignForJob(sizeof(SharedState) + 2 * slot_count * sizeof(std::size_t));
+    return reinterpret_cast<RenderJob*>(static_cast<char*>(mapping) + offset + index * slot_size);
+}
+
+/**
+ * Creates the shared mapping with all slots on the free stack and forks the
+ * workers. Any failure leaves the farm in in-process mode.
+ */
+bool RenderFarm::Start(std::size_t series_points, std::size_t series_per_job)
+{
+    if (requested_workers == 0 || mapping != nullptr) {
+        return !pids.empty();
+    }
+
+    if (downsampler.IsActive(series_points)) {
+        series_points = downsampler.TargetPoints();
+    }
+    slot_points = series_points > 0
+                ? series_points * std::max<std::size_t>(series_per_job, 1)
+                : DEFAULT_SLOT_POINTS;
+    slot_size = AlignForJob(RenderJob::SlotSize(slot_points));
+    std::size_t offset = AlignForJob(sizeof(SharedState) + 2 * slot_count * sizeof(std::size_t));
+    mapping_size = offset + slot_count * slot_size;
+
+    mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: Could not map shared memory for the render workers: "
+                  << std::strerror(errno) << std::endl;
+        mapping = nullptr;
+        return false;
+    }
+
+    SharedState* state = State();
+    state->head = 0;
+    state->tail = 0;
+    state->free_top = slot_count;
+    state->stopping = 0;
+    state->completed = 0;
+    state->failed = 0;
+    for (std::size_t i = 0; i < slot_count; ++i) {
+        FreeStack()[i] = i;
+        Slot(i)->capacity = slot_points;
+    }
+    if (sem_init(&state->lock, 1, 1) != 0
+        || sem_init(&state->free_slots, 1, slot_count) != 0
+        || sem_init(&state->pending_jobs, 1, 0) != 0) {
+        std::cerr << "Error: Could not create semaphores for the render workers: "
+                  << std::strerror(errno) << std::endl;
+        munmap(mapping, mapping_size);
+        mapping = nullptr;
+        return false;
+    }
+
+    // Buffered output would otherwise be written once more by every worker
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    const pid_t parent = getpid();
+    for (std::size_t i = 0; i < requested_workers; ++i) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            WorkerLoop(parent);
+            _exit(0);
+        }
+        if (pid < 0) {
+            std::cerr << "Error: Could not start render worker: "
+                      << std::strerror(errno) << std::endl;
+            break;
+        }
+        pids.push_back(pid);
+    }
+
+    if (pids.empty()) {
+        munmap(mapping, mapping_size);
+        mapping = nullptr;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Checks the series count, the texts and the points against the slot size.
+ */
+bool RenderFarm::JobFits(
+    const std::string& title, const std::string& output_path,
+    const std::vector<RenderSeries>& series) const
+{
+    if (series.size() > RenderJob::MAX_SERIES || title.size() >= RenderJob::MAX_TEXT
+        || output_path.size() >= RenderJob::MAX_TEXT) {
+        return false;
+    }
+    std::size_t points = 0;
+    for (const RenderSeries& view : series) {
+        if (view.label.size() >= RenderJob::MAX_LABEL) {
+            return false;
+        }
+        points += view.size;
+    }
+    return points <= slot_points;
+}
+
+/**
+ * Lays the series out back to back in the job's point arrays.
+ */
+void RenderFarm::FillJob(
+    RenderJob& job, int kind, const std::string& title,
+    const std::string& output_path, const std::vector<RenderSeries>& series)
+{
+    CopyText(job.title, RenderJob::MAX_TEXT, title);
+    CopyText(job.output_path, RenderJob::MAX_TEXT, output_path);
+    job.kind = kind;
+    job.series_count = series.size();
+    job.offsets[0] = 0;
+    for (std::size_t i = 0; i < series.size(); ++i) {
+        std::size_t begin = job.offsets[i];
+        CopyText(job.labels[i], RenderJob::MAX_LABEL, series[i].label);
+        std::copy(series[i].x, series[i].x + series[i].size, job.X() + begin);
+        std::copy(series[i].y, series[i].y + series[i].size, job.Y() + begin);
+        job.offsets[i + 1] = begin + series[i].size;
+    }
+}
+
+/**
+ * Draws the job with the callback in this process.
+ */
+bool RenderFarm::RenderLocally(
+    int kind, const std::string& title, const std::string& output_path,
+    const std::vector<RenderSeries>& series)
+{
+    if (!callback({kind, title, output_path, series})) {
+        ++local_failures;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Hands the job to the workers. Dense series are downsampled first, into
+ * buffers that live until the job is copied. While all slots are busy the
+ * workers are checked periodically; if none is left, or the job does not fit
+ * into a slot, it is rendered in process from the submitted series.
+ */
+bool RenderFarm::Submit(
+    int kind, const std::string& title, const std::string& output_path,
+    const std::vector<RenderSeries>& series)
+{
+    if (pids.empty()) {
+        return RenderLocally(kind, title, output_path, series);
+    }
+
+    std::vector<RenderSeries> reduced = series;
+    std::vector<std::vector<double>> buffers;
+    buffers.reserve(2 * series.size());
+    for (RenderSeries& view : reduced) {
+        if (!downsampler.IsActive(view.size)) {continue;}
+        buffers.emplace_back();
+        std::vector<double>& x = buffers.back();
+        buffers.emplace_back();
+        std::vector<double>& y = buffers.back();
+        downsampler.Downsample(view.x, view.y, view.size, x, y);
+        view.x = x.data();
+        view.y = y.data();
+        view.size = x.size();
+    }
+    if (!JobFits(title, output_path, reduced)) {
+        return RenderLocally(kind, title, output_path, series);
+    }
+
+    bool has_slot = false;
+    while (!pids.empty() && !has_slot) {
+        has_slot = WaitFor(&State()->free_slots, SLOT_WAIT_MS);
+        if (!has_slot && ReapWorkers() == 0) {
+            std::cerr << "Error: No render workers left, rendering in process."
+                      << std::endl;
+        }
+    }
+    if (!has_slot) {
+        return RenderLocally(kind, title, output_path, series);
+    }
+
+    SharedState* state = State();
+    Wait(&state->lock);
+    std::size_t index = FreeStack()[--state->free_top];
+    sem_post(&state->lock);
+
+    FillJob(*Slot(index), kind, title, output_path, reduced);
+
+    Wait(&state->lock);
+    PendingRing()[state->tail % slot_count] = index;
+    ++state->tail;
+    sem_post(&state->lock);
+    sem_post(&state->pending_jobs);
+    ++submitted;
+    return true;
+}
+
+/**
+ * Renders pending jobs until the queue is empty and the farm is stopping.
+ * An idle worker also returns once its parent is gone, since a farm kept
+ * between batches may be waiting for jobs when the parent is killed.
+ */
+void RenderFarm::WorkerLoop(pid_t parent)
+{
+    SharedState* state = State();
+    for (;;) {
+        while (!WaitFor(&state->pending_jobs, SLOT_WAIT_MS)) {
+            if (getppid() != parent) {
+                return;
+            }
+        }
+
+        Wait(&state->lock);
+        if (state->head == state->tail) {
+            bool stopping = state->stopping != 0;
+            sem_post(&state->lock);
+            if (stopping) {
+                return;
+            }
+            continue;
+        }
+        std::size_t index = PendingRing()[state->head % slot_count];
+        ++state->head;
+        sem_post(&state->lock);
+
+        bool success = callback(Slot(index)->Request());
+
+        Wait(&state->lock);
+        FreeStack()[state->free_top++] = index;
+        if (success) {
+            ++state->completed;
+        } else {
+            ++state->failed;
+        }
+        sem_post(&state->lock);
+        sem_post(&state->free_slots);
+    }
+}
+
+/**
+ * Collects the exit status of workers that have terminated.
+ */
+std::size_t RenderFarm::ReapWorkers()
+{
+    for (auto it = pids.begin(); it != pids.end();) {
+        int status = 0;
+        if (waitpid(*it, &status, WNOHANG) == *it) {
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                std::cerr << "Error: Render worker " << *it
+                          << " terminated abnormally." << std::endl;
+            }
+            it = pids.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return pids.size();
+}
+
+/**
+ * Takes every slot in turn: once the parent holds all of them, no job is
+ * pending or being rendered. A worker that disappears meanwhile may have taken
+ * a slot with it, so the farm is then stopped like in Finish() and later jobs
+ * are rendered in process.
+ */
+std::size_t RenderFarm::Drain()
+{
+    if (mapping == nullptr) {
+        return Finish();
+    }
+
+    SharedState* state = State();
+    const std::size_t running = pids.size();
+    std::size_t held = 0;
+    while (held < slot_count) {
+        if (WaitFor(&state->free_slots, SLOT_WAIT_MS)) {
+            ++held;
+        } else if (ReapWorkers() < running) {
+            break;
+        }
+    }
+    for (std::size_t i = 0; i < held; ++i) {
+        sem_post(&state->free_slots);
+    }
+    if (held < slot_count) {
+        std::cerr << "Error: A render worker was lost, rendering in process." << std::endl;
+        return Finish();
+    }
+
+    Wait(&state->lock);
+    std::size_t failures = local_failures + submitted - std::min(submitted, state->completed);
+    state->completed = 0;
+    state->failed = 0;
+    sem_post(&state->lock);
+    local_failures = 0;
+    submitted = 0;
+    return failures;
+}
+
+/**
+ * Wakes every worker once more with the stop flag set. Workers drain the
+ * remaining jobs first, since the stop signals are queued behind them.
+ * Jobs lost with a crashed worker count as failed.
+ */
+std::size_t RenderFarm::Finish()
+{
+    std::size_t failures = local_failures;
+    local_failures = 0;
+    if (mapping == nullptr) {
+        return failures;
+    }
+
+    SharedState* state = State();
+    Wait(&state->lock);
+    state->stopping = 1;
+    sem_post(&state->lock);
+    for (std::size_t i = 0; i < pids.size(); ++i) {
+        sem_post(&state->pending_jobs);
+    }
+
+    for (pid_t pid : pids) {
+        int status = 0;
+        while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::cerr << "Error: Render worker " << pid
+                      << " terminated abnormally." << std::endl;
+        }
+    }
+    pids.clear();
+
+    failures += submitted - std::min(submitted, state->completed);
+    submitted = 0;
+
+    sem_destroy(&state->lock);
+    sem_destroy(&state->free_slots);
+    sem_destroy(&state->pending_jobs);
+    munmap(mapping, mapping_size);
+    mapping = nullptr;
+    return failures;
+}
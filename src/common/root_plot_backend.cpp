@@ -0,0 +1,143 @@
+/**
+ * @file root_plot_backend.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the RootPlotBackend class drawing plots with ROOT.
+ *
+ * @details
+ * A PlotSpec maps directly onto ROOT objects: one TGraph per curve with the
+ * given colour, line style and markers, a TMultiGraph carrying the titles and
+ * axis ranges and an optional TLegend in the upper right corner of the pad.
+ * Multi-page documents use the paging of TPad::Print ("file.pdf[", pages,
+ * "file.pdf]"), so the file is opened and closed only once.
+ * This file and plot_canvas.cpp form the ROOT plot plugin, the only part of
+ * the project that links against ROOT.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/root_plot_backend.h"
+#include "../include/common/plot_canvas.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include "TAxis.h"
+#include "TCanvas.h"
+#include "TGraph.h"
+#include "TLegend.h"
+#include "TMultiGraph.h"
+
+RootPlotBackend::RootPlotBackend(bool batch_mode)
+{
+    if (batch_mode) {
+        PlotCanvas::EnableBatchMode();
+    }
+}
+
+bool RootPlotBackend::Render(const PlotSpec& spec, const std::string& output_path)
+{
+    return Draw(spec, output_path);
+}
+
+/**
+ * Opens the document with ROOT's paging syntax: printing to "file.pdf[" opens
+ * the file without writing a page.
+ */
+bool RootPlotBackend::OpenDocument(const std::string& output_path)
+{
+    document_path = output_path;
+    PlotCanvas::Acquire("plot_document")->Print((document_path + "[").c_str());
+    return true;
+}
+
+bool RootPlotBackend::AddPage(const PlotSpec& spec)
+{
+    if (document_path.empty()) {
+        std::cerr << "Error: No plot document is open." << std::endl;
+        return false;
+    }
+    return Draw(spec, document_path);
+}
+
+/**
+ * Closes the document by printing to "file.pdf]".
+ */
+bool RootPlotBackend::CloseDocument()
+{
+    if (document_path.empty()) {
+        return false;
+    }
+    PlotCanvas::Acquire("plot_document")->Print((document_path + "]").c_str());
+    document_path.clear();
+    return true;
+}
+
+/**
+ * Builds the graphs, draws them on the pooled canvas and prints it. While a
+ * document is open, printing to its path appends a page. The canvas is cleared
+ * before the graphs, the multigraph and the legend are freed.
+ */
+bool RootPlotBackend::Draw(const PlotSpec& spec, const std::string& print_path)
+{
+    // The multigraph owns the graphs added to it
+    auto mg = std::make_unique<TMultiGraph>();
+    std::unique_ptr<TLegend> legend;
+    if (spec.show_legend) {
+        legend = std::make_unique<TLegend>(0.7, 0.7, 0.9, 0.9);
+    }
+
+    for (const PlotCurve& curve : spec.curves) {
+        const int n = int(std::min(curve.x.size(), curve.y.size()));
+        auto graph = std::make_unique<TGraph>(n, curve.x.data(), curve.y.data());
+        graph->SetTitle(curve.label.c_str());
+        graph->SetLineColor(curve.color);
+        graph->SetLineStyle(curve.line_style);
+        graph->SetLineWidth(curve.line_width);
+        graph->SetMarkerColor(curve.color);
+        graph->SetMarkerStyle(20);
+        graph->SetMarkerSize(curve.marker_size);
+
+        std::string draw_option, legend_option;
+        if (curve.draw_line) {
+            draw_option += "L";
+            legend_option += "l";
+        }
+        if (curve.draw_markers) {
+            draw_option += "P";
+            legend_option += "p";
+        }
+        if (legend && !curve.label.empty()) {
+            legend->AddEntry(graph.get(), curve.label.c_str(), legend_option.c_str());
+        }
+        mg->Add(graph.release(), draw_option.c_str());
+    }
+
+    std::string titles = spec.title + ";" + spec.x_title + ";" + spec.y_title;
+    mg->SetTitle(titles.c_str());
+    if (spec.y_max > spec.y_min) {
+        mg->SetMinimum(spec.y_min);
+        mg->SetMaximum(spec.y_max);
+    }
+
+    TCanvas* canvas = PlotCanvas::Acquire(spec.canvas_title, spec.width, spec.height);
+    mg->Draw("A");
+    if (spec.x_max > spec.x_min) {
+        mg->GetXaxis()->SetLimits(spec.x_min, spec.x_max);
+    }
+    if (legend) {
+        legend->Draw();
+    }
+    canvas->Modified();
+    canvas->Update();
+
+    canvas->Print(print_path.c_str());
+    canvas->Clear(); // Detach the plot objects before they are freed
+    return true;
+}
+
+extern "C" PlotBackend* CreateRootPlotBackend()
+{
+    return new RootPlotBackend();
+}
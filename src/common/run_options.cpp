@@ -0,0 +1,220 @@
+/**
+ * @file run_options.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Command line options shared by the commands of nucleon_momentum_distribution.
+ *
+ * @details
+ * The options follow the command; flags stand alone and all other options take
+ * one value. Counts are parsed strictly, so a typo is reported rather than
+ * silently read as zero.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/run_options.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Parses a non-negative decimal integer that fills the whole text. Signs,
+ * blanks and values beyond the range of size_t are rejected.
+ */
+static bool ParseUnsigned(const char* text, size_t& value)
+{
+    if (!std::isdigit(static_cast<unsigned char>(*text))) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed > SIZE_MAX) {
+        return false;
+    }
+    value = size_t(parsed);
+    return true;
+}
+
+/**
+ * Malformed values are reported and treated like an unset variable.
+ */
+size_t EnvironmentCount(const char* name)
+{
+    const char* value = std::getenv(name);
+    size_t count = 0;
+    if (value != nullptr && *value != '\0' && !ParseUnsigned(value, count)) {
+        std::cerr << "Warning: Ignoring " << name << "=" << value
+                  << ", a non-negative integer is expected." << std::endl;
+        return 0;
+    }
+    return count;
+}
+
+/**
+ * Prints the available commands and options.
+ */
+void PrintUsage(const std::string& program)
+{
+    std::cerr << "Usage: " << program << " <command> [options]\n\n"
+              << "Commands:\n"
+              << "  deuteron   Calculate and plot the nucleon momentum distributions"
+                 " in the deuteron\n"
+              << "  helium     Convert and plot the momentum distributions in 3He\n"
+              << "  serve      Answer distribution queries over a Unix domain socket\n\n"
+              << "Options:\n"
+              << "  --config <file>         Model configuration"
+                 " (deuteron; default src/deuteron/models_config.json)\n"
+              << "  --input-dir <dir>       Directory of the 3He input tables"
+                 " (helium; default input)\n"
+              << "  --data-dir <dir>        Output directory of the distributions (default data)\n"
+              << "  --plot-dir <dir>        Output directory of the plots (default plots)\n"
+              << "  --socket <path>         Socket of the query server"
+                 " (serve; default momentum_distribution.sock)\n"
+              << "  --models <a,b,...>      Process only these models or 3He tables\n"
+              << "  --steps <n>             Number of momentum grid intervals"
+                 " (deuteron; default 400)\n"
+              << "  --max-momentum <p>      Upper end of the momentum grid in GeV/c"
+                 " (deuteron; default 0.4)\n"
+              << "  --threads <n>           Threads calculating distributions (default 1)\n"
+              << "  --format <text|binary>  Format of the distribution files (default text)\n"
+              << "  --watch                 Keep running and update the outputs of changed"
+                 " models or tables\n"
+              << "  --publish               Also publish the distributions as shared memory"
+                 " (/dev/shm/nmd_<name>)\n"
+              << "  --no-plot               Write the distributions only\n"
+              << "  --plot-backend <name>   Plot backend: root or lite"
+                 " (default $PLOT_BACKEND or root)\n"
+              << "  --plot-workers <n>      Render worker processes (default $PLOT_WORKERS or 0)\n"
+              << "  --max-plot-points <n>   Points drawn per curve, 0 for all"
+                 " (default $PLOT_MAX_POINTS or 0)\n"
+              << "  --plot-document <file>  Write all deuteron plots as pages of one PDF\n"
+              << "  --force-plot            Redraw plots that are up to date" << std::endl;
+}
+
+/**
+ * Parses a non-negative integer option value.
+ */
+static bool ParseCount(const std::string& option, const char* value, size_t& count)
+{
+    if (!ParseUnsigned(value, count)) {
+        std::cerr << "Error: Option " << option << " expects a non-negative integer." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Parses the options following the command into a RunOptions structure.
+ */
+bool ParseOptions(int argc, char* argv[], int first, RunOptions& options)
+{
+    for (int i = first; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--no-plot") {
+            options.plot = false;
+            continue;
+        }
+        if (option == "--force-plot") {
+            options.force_plot = true;
+            continue;
+        }
+        if (option == "--watch") {
+            options.watch = true;
+            continue;
+        }
+        if (option == "--publish") {
+            options.publish = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Error: Unknown option or missing value: " << option << std::endl;
+            return false;
+        }
+        const char* value = argv[++i];
+        size_t count = 0;
+
+        if (option == "--config") {
+            options.config_file = value;
+        } else if (option == "--input-dir") {
+            options.input_dir = value;
+        } else if (option == "--data-dir") {
+            options.data_dir = value;
+        } else if (option == "--plot-dir") {
+            options.plot_dir = value;
+        } else if (option == "--socket") {
+            options.socket_path = value;
+        } else if (option == "--models") {
+            std::string list = value;
+            size_t begin = 0;
+            while (begin <= list.size()) {
+                size_t comma = std::min(list.find(',', begin), list.size());
+                if (comma > begin) {options.models.push_back(list.substr(begin, comma - begin));}
+                begin = comma + 1;
+            }
+        } else if (option == "--steps") {
+            if (!ParseCount(option, value, count) || count == 0 || count > INT_MAX) {
+                std::cerr << "Error: Option --steps expects a positive number of intervals."
+                          << std::endl;
+                return false;
+            }
+            options.steps = int(count);
+        } else if (option == "--max-momentum") {
+            char* end = nullptr;
+            options.max_momentum = std::strtod(value, &end);
+            if (*end != '\0' || !(options.max_momentum > 0.)) {
+                std::cerr << "Error: Option --max-momentum expects a positive momentum in GeV/c."
+                          << std::endl;
+                return false;
+            }
+        } else if (option == "--threads") {
+            if (!ParseCount(option, value, options.threads)) {return false;}
+        } else if (option == "--format") {
+            std::string format = value;
+            if (format != "text" && format != "binary") {
+                std::cerr << "Error: Option --format expects text or binary." << std::endl;
+                return false;
+            }
+            options.binary = format == "binary";
+        } else if (option == "--plot-backend") {
+            options.plot_backend = value;
+        } else if (option == "--plot-workers") {
+            if (!ParseCount(option, value, options.plot_workers)) {return false;}
+        } else if (option == "--max-plot-points") {
+            if (!ParseCount(option, value, options.max_plot_points)) {return false;}
+        } else if (option == "--plot-document") {
+            options.plot_document = value;
+        } else {
+            std::cerr << "Error: Unknown option: " << option << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Checks that every selected name is available; reports the unknown ones.
+ */
+bool CheckSelection(
+    const std::vector<std::string>& selected, const std::vector<std::string>& available)
+{
+    bool valid = true;
+    for (const std::string& name : selected) {
+        if (std::find(available.begin(), available.end(), name) == available.end()) {
+            std::cerr << "Error: Unknown model '" << name << "'." << std::endl;
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+bool IsSelected(const RunOptions& options, const std::string& name)
+{
+    return options.models.empty()
+        || std::find(options.models.begin(), options.models.end(), name) != options.models.end();
+}
@@ -0,0 +1,139 @@
+/**
+ * @file serve_command.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the serve command.
+ *
+ * @details
+ * The catalog of samplers is built from the selected deuteron models and 3He
+ * tables and published to a QueryServer. A reload thread with its own
+ * calculator watches the inputs and publishes a new catalog after every change;
+ * it is woken and joined once the server stops. A rebuild that fails keeps
+ * the previous catalog in service.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/serve_command.h"
+#include "../include/common/file_watcher.h"
+#include "../include/common/parallel_for.h"
+#include "../include/common/query_server.h"
+#include "../include/deuteron/deuteron_command.h"
+#include "../include/deuteron/model_config.h"
+#include "../include/helium/helium_command.h"
+#include "../include/helium/momentum_data_loader.h"
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using json = nlohmann::json;
+
+/**
+ * Calculates the selected deuteron models and loads the selected 3He tables
+ * into a catalog of samplers for the query server.
+ */
+static bool BuildCatalog(
+    const RunOptions& options, MomentumDistributionCalculator& calculator,
+    QueryServer::Catalog& catalog)
+{
+    std::vector<json> all_models, models;
+    if (!LoadModels(options.config_file, all_models)) {
+        return false;
+    }
+    for (const json& model : all_models) {
+        if (IsSelected(options, model["name"])) {models.push_back(model);}
+    }
+    std::vector<std::vector<double>> momenta(models.size()), densities(models.size());
+    ParallelFor(models.size(), options.threads, [&](size_t i) {
+        double alpha = models[i]["alpha"];
+        double m_0 = models[i]["m_0"];
+        std::vector<double> c = models[i]["parameters"]["c"];
+        std::vector<double> d = models[i]["parameters"]["d"];
+        calculator.CalculateDistribution(alpha, m_0, c, d, momenta[i], densities[i]);
+    });
+
+    catalog.clear();
+    for (size_t i = 0; i < models.size(); ++i) {
+        std::string model_name = models[i]["name"];
+        if (!catalog[model_name].Build(momenta[i].data(), densities[i].data(), momenta[i].size())) {
+            std::cerr << "Error: Model " << model_name << " cannot be served." << std::endl;
+            catalog.erase(model_name);
+        }
+    }
+    for (const HeliumTable& table : HELIUM_TABLES) {
+        if (!IsSelected(options, table.name)) {continue;}
+        MomentumDataLoader loader;
+        std::vector<double> table_momenta, table_densities;
+        for (const auto& [momentum, probability] : loader.LoadProcessedData(
+                 options.input_dir + "/" + table.name + ".txt", table.is_momentum_in_fm,
+                 table.is_prob_normalized)) {
+            table_momenta.push_back(momentum);
+            table_densities.push_back(probability);
+        }
+        if (!catalog[table.name].Build(table_momenta.data(), table_densities.data(),
+                                       table_momenta.size())) {
+            std::cerr << "Error: Table " << table.name << " cannot be served." << std::endl;
+            catalog.erase(table.name);
+        }
+    }
+    return true;
+}
+
+int RunServer(const RunOptions& options)
+{
+    MomentumDistributionCalculator calculator;
+    if (!ApplyGridOptions(options, calculator)) {
+        return 1;
+    }
+
+    QueryServer server;
+    QueryServer::Catalog catalog;
+    if (!BuildCatalog(options, calculator, catalog)) {
+        return -1;
+    }
+    size_t model_count = catalog.size();
+    server.Publish(std::move(catalog));
+    if (!server.Listen(options.socket_path)) {
+        return 1;
+    }
+    std::cout << "Serving " << model_count << " models on " << options.socket_path
+              << " (Ctrl+C to stop)." << std::endl;
+
+    // Hot reload on a thread with its own copy of the calculator; it is woken
+    // and joined once the server stops
+    FileWatcher watcher;
+    bool watching = watcher.Add(options.config_file);
+    for (const HeliumTable& table : HELIUM_TABLES) {
+        watching = watching && watcher.Add(options.input_dir + "/" + table.name + ".txt");
+    }
+    std::thread reloader([&options, &server, &watcher, watching, calculator]() mutable {
+        while (watching && !watcher.WaitForChanges().empty()) {
+            // A failed rebuild leaves the current catalog in place
+            QueryServer::Catalog updated;
+            bool built = false;
+            try {
+                built = BuildCatalog(options, calculator, updated);
+            } catch (const std::exception& error) {
+                std::cerr << "Error: " << error.what() << std::endl;
+            }
+            if (!built) {
+                std::cerr << "Error: Reloading the models failed, still serving version "
+                          << server.Version() << "." << std::endl;
+                continue;
+            }
+            server.Publish(std::move(updated));
+            std::cout << "Reloaded the models (version " << server.Version() << ")."
+                      << std::endl;
+        }
+    });
+
+    bool served = server.Run();
+    watcher.Interrupt();
+    reloader.join();
+    return served ? 0 : 1;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file shared_table.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the SharedTable class for distribution tables in
+ *        POSIX shared memory.
+ *
+ * @details
+ * Publishing unlinks the previous segment of the name and creates a fresh
+ * one, so the pages mapped by existing readers are never written again. The
+ * columns and header fields are filled first and the magic is stored last with
+ * release ordering; a reader that finds the segment before that sees no
+ * magic and reports the table as not ready. Finally the previous segment is
+ * flagged as superseded. The header occupies 128 bytes, which keeps both
+ * columns aligned to cache lines.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/shared_table.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+constexpr char SharedTableHeader::MAGIC[8];
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Shared table headers need lock-free 64-bit atomics");
+
+const std::uint64_t HEADER_SIZE = 128;  // Header rounded up to two cache lines
+static_assert(sizeof(SharedTableHeader) <= HEADER_SIZE, "Shared table header too large");
+
+/**
+ * The magic as the 64-bit word stored in the header.
+ */
+static std::uint64_t MagicWord()
+{
+    std::uint64_t word;
+    std::memcpy(&word, SharedTableHeader::MAGIC, sizeof(word));
+    return word;
+}
+
+/**
+ * Segment name of a table, or an empty string if the table name is not usable.
+ */
+static std::string SegmentName(const std::string& name)
+{
+    if (name.empty() || name.size() >= sizeof(SharedTableHeader::name)) {
+        return "";
+    }
+    for (char c : name) {
+        bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+                    || c == '_' || c == '-' || c == '.';
+        if (!allowed) {return "";}
+    }
+    return "/nmd_" + name;
+}
+
+SharedTable::~SharedTable()
+{
+    Detach();
+}
+
+std::uint64_t SharedTable::Publish(
+    const std::string& name, const double* momenta, const double* densities, std::size_t count)
+{
+    std::string segment = SegmentName(name);
+    if (segment.empty()) {
+        std::cerr << "Error: Invalid shared table name: " << name << std::endl;
+        return 0;
+    }
+
+    // The version continues from the table being replaced
+    std::uint64_t version = 1;
+    SharedTableHeader* previous = nullptr;
+    int previous_descriptor = shm_open(segment.c_str(), O_RDWR, 0);
+    if (previous_descriptor >= 0) {
+        struct stat status;
+        if (fstat(previous_descriptor, &status) == 0 && std::uint64_t(status.st_size) >= HEADER_SIZE) {
+            void* mapping = mmap(nullptr, HEADER_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, previous_descriptor, 0);
+            if (mapping != MAP_FAILED) {
+                previous = static_cast<SharedTableHeader*>(mapping);
+                if (previous->magic.load(std::memory_order_acquire) == MagicWord()) {
+                    version = previous->version + 1;
+                }
+            }
+        }
+        close(previous_descriptor);
+        shm_unlink(segment.c_str());
+    }
+
+    std::size_t size = HEADER_SIZE + 2 * count * sizeof(double);
+    int descriptor = shm_open(segment.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (descriptor < 0 || ftruncate(descriptor, off_t(size)) != 0) {
+        std::cerr << "Error: Could not create shared table " << segment << ": " << std::strerror(errno) << std::endl;
+        if (descriptor >= 0) {
+            close(descriptor);
+            shm_unlink(segment.c_str());
+        }
+        if (previous != nullptr) {munmap(previous, HEADER_SIZE);}
+        return 0;
+    }
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: Could not map shared table " << segment << ": " << std::strerror(errno) << std::endl;
+        shm_unlink(segment.c_str());
+        if (previous != nullptr) {munmap(previous, HEADER_SIZE);}
+        return 0;
+    }
+
+    // The new segment is zero-filled, so the magic reads as absent until stored
+    SharedTableHeader* header = static_cast<SharedTableHeader*>(mapping);
+    double* columns = reinterpret_cast<double*>(static_cast<char*>(mapping) + HEADER_SIZE);
+    std::memcpy(columns, momenta, count * sizeof(double));
+    std::memcpy(columns + count, densities, count * sizeof(double));
+    header->header_size = HEADER_SIZE;
+    header->version = version;
+    header->count = count;
+    std::memcpy(header->name, name.c_str(), name.size());
+    header->magic.store(MagicWord(), std::memory_order_release);
+    munmap(mapping, size);
+
+    if (previous != nullptr) {
+        previous->superseded.store(1, std::memory_order_release);
+        munmap(previous, HEADER_SIZE);
+    }
+    return version;
+}
+
+std::uint64_t SharedTable::Publish(
+    const std::string& name, const float* momenta, const float* densities, std::size_t count)
+{
+    std::vector<double> momentum_column(momenta, momenta + count);
+    std::vector<double> density_column(densities, densities + count);
+    return Publish(name, momentum_column.data(), density_column.data(), count);
+}
+
+bool SharedTable::Remove(const std::string& name)
+{
+    std::string segment = SegmentName(name);
+    return !segment.empty() && shm_unlink(segment.c_str()) == 0;
+}
+
+bool SharedTable::Attach(const std::string& name)
+{
+    Detach();
+    std::string segment = SegmentName(name);
+    int descriptor = segment.empty() ? -1 : shm_open(segment.c_str(), O_RDONLY, 0);
+    if (descriptor < 0) {
+        std::cerr << "Error: Shared table " << name << " is not published." << std::endl;
+        return false;
+    }
+    struct stat status;
+    void* mapping = MAP_FAILED;
+    if (fstat(descriptor, &status) == 0 && std::uint64_t(status.st_size) >= HEADER_SIZE) {
+        mapping = mmap(nullptr, std::size_t(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    }
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: Could not map shared table " << name << "." << std::endl;
+        return false;
+    }
+
+    const SharedTableHeader* candidate = static_cast<const SharedTableHeader*>(mapping);
+    std::uint64_t size = std::uint64_t(status.st_size);
+    if (candidate->magic.load(std::memory_order_acquire) != MagicWord()
+        || candidate->header_size < sizeof(SharedTableHeader) || candidate->header_size > size
+        || candidate->count > (size - candidate->header_size) / (2 * sizeof(double))) {
+        std::cerr << "Error: Shared table " << name << " is incomplete or not a distribution table." << std::endl;
+        munmap(mapping, std::size_t(size));
+        return false;
+    }
+    header = candidate;
+    mapping_size = std::size_t(size);
+    return true;
+}
+
+void SharedTable::Detach()
+{
+    if (header != nullptr) {
+        munmap(const_cast<SharedTableHeader*>(header), mapping_size);
+        header = nullptr;
+        mapping_size = 0;
+    }
+}
+
+const double* SharedTable::Momenta() const
+{
+    if (header == nullptr) {
+        return nullptr;
+    }
+    return reinterpret_cast<const double*>(reinterpret_cast<const char*>(header) + header->header_size);
+}
+
+const double* SharedTable::Densities() const
+{
+    return header != nullptr ? Momenta() + header->count : nullptr;
+}
@@ -0,0 +1,330 @@
+/**
+ * @file deuteron_command.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the deuteron command.
+ *
+ * @details
+ * The selected models are calculated, written and plotted in a pipeline of
+ * calculation threads, a writer thread and the plotting on the calling thread.
+ * The plots are drawn by a RenderFarm, in forked workers or in process. In
+ * watch mode the distributions are kept between runs, so only changed models
+ * are calculated again.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/deuteron/deuteron_command.h"
+#include "../include/deuteron/model_config.h"
+#include "../include/deuteron/plot_generator_deuteron.h"
+#include "../include/common/bounded_queue.h"
+#include "../include/common/distribution_file.h"
+#include "../include/common/file_watcher.h"
+#include "../include/common/render_farm.h"
+#include "../include/common/shared_table.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <thread>
+#include <utility>
+
+using json = nlohmann::json;
+
+// Plot kinds handled by the render workers
+const int SINGLE_PLOT = 0;
+const int COMBINED_PLOT = 1;
+
+// Models buffered between two stages of the calculation pipeline
+const size_t PIPELINE_DEPTH = 4;
+
+/**
+ * Calculated distribution of one deuteron model, kept for the plots and for
+ * later runs in watch mode.
+ */
+struct ModelDistribution {
+    json model;                     // Model entry of the configuration
+    std::vector<double> momenta;
+    std::vector<double> densities;
+    bool written = false;           // Distribution file was written
+};
+
+bool ApplyGridOptions(const RunOptions& options, MomentumDistributionCalculator& calculator)
+{
+    if (options.steps == 0 && options.max_momentum == 0.) {
+        return true;
+    }
+    return calculator.SetGrid(options.steps > 0 ? options.steps : calculator.Steps(),
+                              options.max_momentum > 0. ? options.max_momentum
+                                                        : calculator.MaxMomentum());
+}
+
+/**
+ * Calculates, writes and plots the models flagged for recalculation. The plots
+ * of the other models are only redrawn where a multi-page document or the
+ * combined plot needs them.
+ */
+static void ProcessModels(
+    const RunOptions& options, MomentumDistributionCalculator& calculator,
+    PlotGeneratorDeuteron& generator_d, RenderFarm& render_farm,
+    std::vector<ModelDistribution>& distributions, const std::vector<bool>& recalculate)
+{
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < distributions.size(); ++i) {
+        if (recalculate[i]) {pending.push_back(i);}
+    }
+    // Three stages run concurrently, connected by bounded queues: the calculation
+    // threads, a writer storing the files in configuration order and the plotting on
+    // this thread, the only one that draws. Model i + 1 is calculated while model i
+    // is written and model i - 1 is plotted.
+    const size_t pending_count = pending.size();
+    const size_t calculation_threads = std::min(std::max<size_t>(options.threads, 1),
+                                                std::max<size_t>(pending_count, 1));
+    BoundedQueue<size_t> calculated(calculation_threads + PIPELINE_DEPTH);
+    BoundedQueue<size_t> written(PIPELINE_DEPTH);
+
+    std::atomic<size_t> next_model(0);
+    std::atomic<size_t> running_calculations(calculation_threads);
+    std::vector<std::thread> calculation_pool;
+    for (size_t t = 0; t < calculation_threads; ++t) {
+        calculation_pool.emplace_back([&]() {
+            for (size_t k = next_model++; k < pending_count; k = next_model++) {
+                ModelDistribution& distribution = distributions[pending[k]];
+                double alpha = distribution.model["alpha"];
+                double m_0 = distribution.model["m_0"];
+                std::vector<double> c = distribution.model["parameters"]["c"];
+                std::vector<double> d = distribution.model["parameters"]["d"];
+                calculator.CalculateDistribution(alpha, m_0, c, d,
+                                                 distribution.momenta, distribution.densities);
+                calculated.Push(k);
+            }
+            if (--running_calculations == 0) {
+                calculated.Close();
+            }
+        });
+    }
+
+    std::thread writer([&]() {
+        // Models may finish out of order on several threads; they are written in order
+        std::vector<bool> ready(pending_count, false);
+        size_t next_to_write = 0, k = 0;
+        while (calculated.Pop(k)) {
+            ready[k] = true;
+            for (; next_to_write < pending_count && ready[next_to_write]; ++next_to_write) {
+                ModelDistribution& distribution = distributions[pending[next_to_write]];
+                std::string model_name = distribution.model["name"];
+                const std::vector<double>& momentum = distribution.momenta;
+                const std::vector<double>& density = distribution.densities;
+                distribution.written = false;
+
+                // Construct output filename based on the model name.
+                std::string data_file = options.data_dir + "/" + model_name
+                                      + "_momentum_distribution"
+                                      + (options.binary ? ".bin" : ".txt");
+                if (options.binary) {
+                    if (!DistributionFile::WriteBinary(data_file, momentum.data(), density.data(),
+                                                       momentum.size())) {
+                        continue; // Skip this model if the file can't be written
+                    }
+                    std::cout << "Momentum distribution calculation completed and saved to file."
+                              << std::endl;
+                } else {
+                    std::ofstream out_file(data_file);
+                    if (!out_file.is_open()) {
+                        std::cerr << "Error: Failed to open output file for writing for "
+                                  << model_name << " model." << std::endl;
+                        continue; // Skip this model if the file can't be opened
+                    }
+                    calculator.WriteDistribution(out_file, momentum, density);
+                }
+                if (options.publish) {
+                    SharedTable::Publish(model_name, momentum.data(), density.data(),
+                                         momentum.size());
+                }
+                distribution.written = true;
+                written.Push(pending[next_to_write]);
+            }
+        }
+        written.Close();
+    });
+
+    // Plot each model's distribution from memory as soon as it has been written.
+    // Pages of a document follow the configuration order, so unchanged models
+    // are paged in between the recalculated ones.
+    const bool document_open = options.plot && !options.plot_document.empty()
+                            && generator_d.BeginPlotDocument(options.plot_document);
+    // A view may only be taken once its model is written: until then the
+    // calculation threads resize the columns.
+    auto series_of = [&distributions](size_t i) -> RenderSeries {
+        const ModelDistribution& distribution = distributions[i];
+        return {distribution.model["name"], distribution.momenta.data(),
+                distribution.densities.data(), distribution.momenta.size()};
+    };
+    size_t next_page = 0;
+    auto add_pages_until = [&](size_t end) {
+        for (; next_page < end; ++next_page) {
+            if (distributions[next_page].written) {
+                RenderSeries page = series_of(next_page);
+                generator_d.AddSinglePlotPage({page.label, page.x, page.y, page.size});
+            }
+        }
+    };
+    size_t model_index = 0;
+    while (written.Pop(model_index)) {
+        if (options.plot && options.plot_document.empty()) {
+            RenderSeries series = series_of(model_index);
+            render_farm.Submit(SINGLE_PLOT, series.label,
+                               options.plot_dir + "/" + series.label + "_distribution.png",
+                               {series});
+        } else if (document_open) {
+            add_pages_until(model_index + 1);
+        }
+    }
+    for (std::thread& thread : calculation_pool) {
+        thread.join();
+    }
+    writer.join();
+
+    if (!options.plot) {
+        render_farm.Drain();
+        return;
+    }
+    // The combined plot starts once all distributions are written.
+    std::vector<RenderSeries> combined;
+    for (size_t i = 0; i < distributions.size(); ++i) {
+        if (distributions[i].written) {combined.push_back(series_of(i));}
+    }
+    if (!options.plot_document.empty()) {
+        // The combined plot is the last page of the document.
+        std::vector<DistributionView> views;
+        for (const RenderSeries& view : combined) {
+            views.push_back({view.label, view.x, view.y, view.size});
+        }
+        if (document_open) {
+            add_pages_until(distributions.size());
+            generator_d.AddCombinedPlotPage(views);
+            generator_d.EndPlotDocument();
+        }
+    } else {
+        // Generate a combined plot for all models.
+        render_farm.Submit(COMBINED_PLOT, "Combined Fermi Momentum Distribution",
+                           options.plot_dir + "/combined_distribution_deuteron.png", combined);
+    }
+    if (render_farm.Drain() > 0) {
+        std::cerr << "Error: Some plots could not be rendered." << std::endl;
+    }
+}
+
+int RunDeuteron(const RunOptions& options)
+{
+    // Load model parameters from the JSON file
+    std::vector<json> all_models;
+    if (!LoadModels(options.config_file, all_models)) {
+        return -1;
+    }
+    std::vector<std::string> model_names;
+    std::vector<ModelDistribution> distributions;
+    for (const json& model : all_models) {
+        model_names.push_back(model["name"]);
+        if (IsSelected(options, model_names.back())) {
+            distributions.push_back({model, {}, {}, false});
+        }
+    }
+    if (!CheckSelection(options.models, model_names)) {
+        return 1;
+    }
+
+    MomentumDistributionCalculator calculator;
+    if (!ApplyGridOptions(options, calculator)) {
+        return 1;
+    }
+
+    PlotGeneratorDeuteron generator_d(CreatePlotBackend(options.plot_backend));
+    generator_d.SetMaxPlotPoints(options.max_plot_points);
+    generator_d.SetForceRender(options.force_plot);
+
+    // Plots are drawn by forked workers (or in process), the data is computed here once
+    auto render = [&generator_d](const RenderRequest& job) {
+        std::vector<DistributionView> views;
+        for (const RenderSeries& series : job.series) {
+            views.push_back({series.label, series.x, series.y, series.size});
+        }
+        if (job.kind == COMBINED_PLOT) {
+            generator_d.GenerateCombinedPlot(views, job.output_path);
+        } else {
+            generator_d.GenerateSinglePlot(views.front(), job.output_path);
+        }
+        return true;
+    };
+    RenderFarm render_farm(options.plot ? options.plot_workers : 0, render);
+    render_farm.SetMaxPlotPoints(options.max_plot_points);
+    if (options.plot_document.empty()) {
+        // The workers are forked once, before this process draws anything. A slot
+        // holds the combined plot, i.e. every model's curve after downsampling;
+        // in watch mode models may be added, up to the series limit of a job.
+        render_farm.Start(calculator.Steps() + 1,
+                          options.watch ? RenderJob::MAX_SERIES : distributions.size());
+    }
+
+    ProcessModels(options, calculator, generator_d, render_farm, distributions,
+                  std::vector<bool>(distributions.size(), true));
+    if (!options.watch) {
+        return 0;
+    }
+
+    FileWatcher watcher;
+    if (!watcher.Add(options.config_file)) {
+        return 1;
+    }
+    std::cout << "Watching " << options.config_file << " for changes (Ctrl+C to stop)."
+              << std::endl;
+    while (!watcher.WaitForChanges().empty()) {
+        auto start = std::chrono::steady_clock::now();
+        if (!LoadModels(options.config_file, all_models)) {
+            continue; // Keep the previous results until the configuration is valid again
+        }
+
+        // Unchanged entries keep their distributions; the order follows the new configuration
+        std::map<std::string, size_t> previous_index;
+        std::vector<std::string> previous_names;
+        for (size_t i = 0; i < distributions.size(); ++i) {
+            previous_names.push_back(distributions[i].model["name"]);
+            previous_index[previous_names.back()] = i;
+        }
+        std::vector<ModelDistribution> updated;
+        std::vector<std::string> updated_names;
+        std::vector<bool> recalculate;
+        for (const json& model : all_models) {
+            std::string model_name = model["name"];
+            if (!IsSelected(options, model_name)) {continue;}
+            auto previous = previous_index.find(model_name);
+            if (previous != previous_index.end()
+                && distributions[previous->second].model == model) {
+                updated.push_back(std::move(distributions[previous->second]));
+                recalculate.push_back(false);
+            } else {
+                updated.push_back({model, {}, {}, false});
+                recalculate.push_back(true);
+            }
+            updated_names.push_back(model_name);
+        }
+        distributions = std::move(updated);
+
+        size_t changed = std::count(recalculate.begin(), recalculate.end(), true);
+        if (changed == 0 && updated_names == previous_names) {
+            std::cout << "No model changed." << std::endl;
+            continue;
+        }
+
+        ProcessModels(options, calculator, generator_d, render_farm, distributions, recalculate);
+        double elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "Updated " << changed << " of " << distributions.size() << " models in "
+                  << elapsed_ms << " ms." << std::endl;
+    }
+    return 1;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file model_config.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Loading and validation of the deuteron model configuration.
+ *
+ * @details
+ * The configuration is a JSON object whose "models" array holds one entry per
+ * nucleon-nucleon potential: its name, alpha, m_0 and the coefficients c and d
+ * of the Yukawa terms. Entries are checked completely before any is returned,
+ * so callers can read them without further tests.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/deuteron/model_config.h"
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+using json = nlohmann::json;
+
+/**
+ * Checks that a number array has only numeric elements.
+ */
+static bool IsNumberArray(const json& array)
+{
+    if (!array.is_array()) {
+        return false;
+    }
+    for (const json& element : array) {
+        if (!element.is_number()) {return false;}
+    }
+    return true;
+}
+
+/**
+ * Checks that a model entry has a name, alpha, m_0 and coefficient arrays c and
+ * d of equal length with at least three terms, so that it can be calculated.
+ * Keys are tested before they are read: indexing a const json with a missing
+ * key is undefined behaviour.
+ */
+static bool IsCompleteModel(const json& model)
+{
+    if (!model.is_object() || !model.contains("name") || !model["name"].is_string()
+        || !model.contains("alpha") || !model["alpha"].is_number()
+        || !model.contains("m_0") || !model["m_0"].is_number()
+        || !model.contains("parameters") || !model["parameters"].is_object()) {
+        return false;
+    }
+    const json& parameters = model["parameters"];
+    return parameters.contains("c") && parameters.contains("d")
+        && IsNumberArray(parameters["c"]) && IsNumberArray(parameters["d"])
+        && parameters["c"].size() == parameters["d"].size() && parameters["c"].size() >= 3;
+}
+
+bool LoadModels(const std::string& config_file, std::vector<json>& models)
+{
+    std::ifstream json_file(config_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Error: Failed to open JSON file " << config_file << " for reading."
+                  << std::endl;
+        return false;
+    }
+    json model_params = json::parse(json_file, nullptr, false);
+    if (model_params.is_discarded() || !model_params.is_object()
+        || !model_params.contains("models") || !model_params["models"].is_array()) {
+        std::cerr << "Error: " << config_file << " is not a valid model configuration."
+                  << std::endl;
+        return false;
+    }
+
+    std::vector<json> loaded;
+    try {
+        for (const auto& model : model_params["models"]) {
+            if (!IsCompleteModel(model)) {
+                std::cerr << "Error: Incomplete model entry in " << config_file << "." << std::endl;
+                return false;
+            }
+            loaded.push_back(model);
+        }
+    } catch (const json::exception& error) {
+        std::cerr << "Error: " << config_file << ": " << error.what() << std::endl;
+        return false;
+    }
+    models = std::move(loaded);
+    return true;
+}
@@ -27,6 +27,33 @@
 
 MomentumDistributionCalculator::MomentumDistributionCalculator() {}
 
+bool MomentumDistributionCalculator::SetGrid(int steps, double max_momentum)
+{
+    if (steps < 1 || !(max_momentum > 0.)) {
+        std::cerr << "Error: The momentum grid needs at least one step and a positive "
+                  << "maximum momentum." << std::endl;
+        return false;
+    }
+    this->steps = steps;
+    this->max_momentum = max_momentum;
+    return true;
+}
+
+/**
+ * Number of decimals that resolves a momentum step: three, or the first count 
+ * at which the step is a whole number of units in the last decimal (at most 10).
+ */
+static int MomentumDecimals(double step)
+{
+    int decimals = 3;
+    double scaled = step * 1e3;
+    while (decimals < 10 && std::fabs(scaled - std::round(scaled)) > 1e-6 * scaled) {
+        ++decimals;
+        scaled *= 10.;
+    }
+    return decimals;
+}
+
 /**
  * Normalizes the coefficients used in the momentum distribution calculation.
 */
@@ -67,14 +94,15 @@ void MomentumDistributionCalculator::NormalizeCoefficients(
  * Calculates the momentum distribution of nucleons within a deuteron for a given 
  * potential model. This function computes the distribution by applying the specified 
  * model parameters, including the 'c' and 'd' coefficients that have been normalized 
- * by `NormalizeCoefficients`. It then outputs the calculated distribution to a file.
+ * by `NormalizeCoefficients`, and stores the momentum grid and the normalized 
+ * distribution in the supplied vectors.
  */
 void MomentumDistributionCalculator::CalculateDistribution(
-    std::ofstream& out_file, double alpha, double m_0, 
-    std::vector<double>& c, std::vector<double>& d) 
+    double alpha, double m_0, 
+    std::vector<double>& c, std::vector<double>& d,
+    std::vector<double>& momentum, std::vector<double>& density) 
 {
     const double dp = max_momentum / steps; // Increment in momentum per step
-    double p[steps + 1], r[steps + 1], f_p[steps + 1]; // Arrays for momentum, reduced momentum, and momentum distribution
     double norm = 0; // Normalization constant
     
     int n = c.size();
@@ -87,35 +115,101 @@ void MomentumDistributionCalculator::CalculateDistribution(
 
     NormalizeCoefficients(c, d, m2);
 
+    momentum.resize(steps + 1);
+    density.resize(steps + 1);
+
     for (int j = 0; j <= steps; ++j) {
 
-        p[j] = j * dp; // Calculate momentum in GeV/c
-        r[j] = p[j] / conversion; // Convert momentum to reduced momentum (GeV/c to fm^-1)
+        momentum[j] = j * dp; // Calculate momentum in GeV/c
+        double r = momentum[j] / conversion; // Convert momentum to reduced momentum (GeV/c to fm^-1)
 
         
         // Calculation for the Paris potential
         double U = 0., W = 0.;
         for (int i = 0; i < n; i++) {
-            U += c[i] / (r[j] * r[j] + m2[i]);
-            W += d[i] / (r[j] * r[j] + m2[i]);
+            U += c[i] / (r * r + m2[i]);
+            W += d[i] / (r * r + m2[i]);
         }
         
         U *= sqrtpi2; // s wave contribution
         W *= sqrtpi2; // d wave contribution
         
         // Calculate momentum distribution and accumulate normalization
-        f_p[j] = r[j] * r[j] * (U * U + W * W);
-        norm += f_p[j];
+        density[j] = r * r * (U * U + W * W);
+        norm += density[j];
     }
     
-    // Normalize and output the momentum distribution
+    // Normalize the momentum distribution
     for (int i = 0; i <= steps; i++) {
-        f_p[i] /= norm;        
-        out_file << std::fixed << std::setprecision(3) << p[i] << "\t" 
-                 << std::setprecision(10) << f_p[i] << std::endl;
+        density[i] /= norm;
+    }
+}
+
+/**
+ * Calculates the reduced deuteron wave functions in coordinate space, 
+ * u(r) = sum c_i exp(-m_i r) and 
+ * w(r) = sum d_i exp(-m_i r) (1 + 3 / (m_i r) + 3 / (m_i r)^2), 
+ * whose Fourier-Bessel transforms are the S- and D-wave amplitudes used in 
+ * the momentum distribution.
+ */
+void MomentumDistributionCalculator::CalculateWaveFunctions(
+    double alpha, double m_0, 
+    std::vector<double>& c, std::vector<double>& d,
+    const std::vector<double>& radii,
+    std::vector<double>& u, std::vector<double>& w) 
+{
+    int n = c.size();
+
+    std::vector<double> m(n), m2(n);
+    for (int i = 0; i < n; i++) {
+        m[i] = alpha + i * m_0;
+        m2[i] = m[i] * m[i];
+    }
+
+    NormalizeCoefficients(c, d, m2);
+
+    u.assign(radii.size(), 0.);
+    w.assign(radii.size(), 0.);
+    for (size_t j = 0; j < radii.size(); ++j) {
+        double r = radii[j];
+        for (int i = 0; i < n; i++) {
+            double x = m[i] * r;
+            double e = std::exp(-x);
+            u[j] += c[i] * e;
+            w[j] += d[i] * e * (1. + 3. / x + 3. / (x * x));
+        }
+    }
+}
+
+/**
+ * Calculates the momentum distribution of nucleons within a deuteron for a given 
+ * potential model and outputs the calculated distribution to a file.
+ */
+void MomentumDistributionCalculator::CalculateDistribution(
+    std::ofstream& out_file, double alpha, double m_0, 
+    std::vector<double>& c, std::vector<double>& d) 
+{
+    std::vector<double> p, f_p; // Momentum and momentum distribution
+    CalculateDistribution(alpha, m_0, c, d, p, f_p);
+    WriteDistribution(out_file, p, f_p);
+}
+
+/**
+ * Writes the momentum distribution to a file, one "momentum<TAB>density" row 
+ * per grid point.
+ */
+void MomentumDistributionCalculator::WriteDistribution(
+    std::ofstream& out_file,
+    const std::vector<double>& momentum, const std::vector<double>& density) 
+{
+    const int decimals = momentum.size() > 1 ? MomentumDecimals(momentum[1] - momentum[0]) : 3;
+
+    // Output the momentum distribution
+    for (size_t i = 0; i < momentum.size(); i++) {
+        out_file << std::fixed << std::setprecision(decimals) << momentum[i] << "\t" 
+                 << std::setprecision(10) << density[i] << std::endl;
     }
     
     std::cout << "Momentum distribution calculation completed and saved to file." 
               << std::endl;
-
 }
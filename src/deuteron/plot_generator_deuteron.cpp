@@ -20,56 +20,87 @@
 #include <vector>
 #include <fstream>
 #include <iostream>
-#include "TGraph.h"
-#include "TCanvas.h"
-#include "TAxis.h"
-#include "TLegend.h"
-#include "TMultiGraph.h"
+#include <memory>
 
-PlotGeneratorDeuteron::PlotGeneratorDeuteron() {}
+PlotGeneratorDeuteron::PlotGeneratorDeuteron(std::unique_ptr<PlotBackend> backend)
+    : backend(std::make_unique<CachedPlotBackend>(
+          backend ? std::move(backend) : CreatePlotBackend(DefaultPlotBackendName()))) {}
 
 /**
- * Generates a plot for the momentum distribution of a single potential model.
- * This function reads momentum and probability density data from a file, creating a plot
- * that visualizes the nucleon momentum distribution under a specified potential.
+ * Reads the two columns of a data file written by MomentumDistributionCalculator.
  */
-void PlotGeneratorDeuteron::GenerateSinglePlot(
-    const std::string& model_name, const std::string& data_file, 
-    const std::string& plot_file)
+bool PlotGeneratorDeuteron::ReadDataFile(
+    const std::string& data_file, std::vector<double>& momentum,
+    std::vector<double>& density)
 {
     std::ifstream in_file(data_file);
     if (!in_file.is_open()) {
         std::cerr << "Error: Failed to open the data file for reading: " 
                   << data_file << std::endl;
-        return;
+        return false;
     }
 
-    std::vector<double> momentum;
-    std::vector<double> density;
+    momentum.clear();
+    density.clear();
     double p, d;
-    
     while (in_file >> p >> d) {
         momentum.push_back(p);
         density.push_back(d);
     }
     in_file.close();
-    
-    // Prepare the TGraph    
-    TGraph* graph = new TGraph(momentum.size(), &momentum[0], &density[0]);
-    std::string title = "Nucleon Momentum Distribution (" + model_name +
-                        " potential);Momentum (GeV/c);Probability Density";
-    graph->SetTitle(title.c_str());
-    graph->SetMarkerStyle(20);
-    graph->SetMarkerSize(0.7);
-    graph->SetDrawOption("AP");
-    
-    // Create a TCanvas and draw the TGraph
-    TCanvas* canvas = new TCanvas("c1", model_name.c_str(), 800, 600);
-    graph->Draw("APL");
-    
-    // Save the plot
-    canvas->SaveAs(plot_file.c_str());
-    delete canvas; // Clean up
+    return true;
+}
+
+/**
+ * Generates a plot for the momentum distribution of a single potential model.
+ * This function plots the momentum and probability density columns computed in memory,
+ * visualizing the nucleon momentum distribution under a specified potential.
+ */
+void PlotGeneratorDeuteron::GenerateSinglePlot(
+    const DistributionView& distribution, const std::string& plot_file)
+{
+    backend->Render(SinglePlotSpec(distribution), plot_file);
+}
+
+/**
+ * Describes the plot of a single potential model: the points of the
+ * distribution joined by a line.
+ */
+PlotSpec PlotGeneratorDeuteron::SinglePlotSpec(const DistributionView& distribution)
+{
+    PlotSpec spec;
+    spec.canvas_title = distribution.model_name;
+    spec.title = "Nucleon Momentum Distribution (" + distribution.model_name + " potential)";
+    spec.x_title = "Momentum (GeV/c)";
+    spec.y_title = "Probability Density";
+
+    // Points joined by a line, from the (possibly downsampled) curve
+    PlotCurve curve;
+    curve.label = distribution.model_name;
+    curve.draw_markers = true;
+    curve.marker_size = 0.7;
+    downsampler.Downsample(distribution.momentum, distribution.density,
+                           distribution.size, curve.x, curve.y);
+    spec.curves.push_back(std::move(curve));
+    return spec;
+}
+
+/**
+ * Generates a plot for the momentum distribution of a single potential model
+ * from the momentum and probability density data stored in a file.
+ */
+void PlotGeneratorDeuteron::GenerateSinglePlot(
+    const std::string& model_name, const std::string& data_file, 
+    const std::string& plot_file)
+{
+    std::vector<double> momentum;
+    std::vector<double> density;
+    if (!ReadDataFile(data_file, momentum, density)) {
+        return;
+    }
+
+    GenerateSinglePlot(
+        {model_name, momentum.data(), density.data(), momentum.size()}, plot_file);
 }
 
 /**
@@ -77,55 +108,92 @@ void PlotGeneratorDeuteron::GenerateSinglePlot(
  * plot. This function facilitates the visual comparison of nucleon momentum 
  * distributions calculated using different nucleon-nucleon potentials.
  */
+void PlotGeneratorDeuteron::GenerateCombinedPlot(
+    const std::vector<DistributionView>& distributions,
+    const std::string& combined_plot_file)
+{
+    backend->Render(CombinedPlotSpec(distributions), combined_plot_file);
+}
+
+/**
+ * Describes the combined plot, with a different line style and colour for
+ * each model.
+ */
+PlotSpec PlotGeneratorDeuteron::CombinedPlotSpec(
+    const std::vector<DistributionView>& distributions)
+{
+    PlotSpec spec;
+    spec.canvas_title = "Combined Fermi Momentum Distribution";
+    spec.title = "Fermi Momentum Distribution";
+    spec.x_title = "Momentum (GeV/c)";
+    spec.y_title = "Probability Density (c/GeV)";
+    spec.x_max = 0.4;
+    spec.y_max = 0.012;
+    spec.show_legend = true;
+
+    for (size_t i = 0; i < distributions.size(); ++i) {
+        const DistributionView& distribution = distributions[i];
+        PlotCurve curve;
+        curve.label = distribution.model_name + " potential";
+        curve.line_width = 2;
+        curve.line_style = 1 + i; // Different line style for each model
+        curve.color = 1 + i;      // Different line color for each model
+        downsampler.Downsample(distribution.momentum, distribution.density,
+                               distribution.size, curve.x, curve.y);
+        spec.curves.push_back(std::move(curve));
+    }
+    return spec;
+}
+
+/**
+ * Combines the momentum distributions of all models in the JSON configuration,
+ * reading each of them from its data file. Models whose file cannot be read are
+ * skipped.
+ */
 void PlotGeneratorDeuteron::GenerateCombinedPlot(
     const nlohmann::json& models, const std::string& combined_plot_file)
 {
-    TMultiGraph *mg = new TMultiGraph();
-    TLegend *legend = new TLegend(0.7, 0.7, 0.9, 0.9);
+    std::vector<std::vector<double>> momenta(models.size());
+    std::vector<std::vector<double>> densities(models.size());
+    std::vector<DistributionView> distributions;
 
+    size_t i = 0;
     for (const auto& model : models) {
         std::string model_name = model["name"];
         std::string data_file = "data/" + model_name 
                               + "_momentum_distribution.txt";
 
-        std::ifstream in_file(data_file);
-        if (!in_file.is_open()) {
-            std::cerr << "Error: Failed to open the data file for reading: " 
-                      << data_file << std::endl;
-            continue; // Skip this model if the file can't be opened
+        if (ReadDataFile(data_file, momenta[i], densities[i])) {
+            distributions.push_back({model_name, momenta[i].data(),
+                                     densities[i].data(), momenta[i].size()});
         }
-
-        std::vector<double> momentum;
-        std::vector<double> density;
-        double p, d;
-        while (in_file >> p >> d) {
-            momentum.push_back(p);
-            density.push_back(d);
-        }
-        in_file.close();
-
-        TGraph* graph = new TGraph(
-            momentum.size(), momentum.data(), density.data()
-        );
-        graph->SetTitle(model_name.c_str());        
-        graph->SetLineWidth(2);
-        graph->SetLineStyle(1 + &model - &models[0]); // Different line style for each model
-        graph->SetLineColor(1 + &model - &models[0]); // Different line color for each model
-        mg->Add(graph);
-        legend->AddEntry(graph, (model_name + " potential").c_str(), "lp");
+        ++i;
     }
 
-    TCanvas *canvas = new TCanvas(
-        "c2", "Combined Fermi Momentum Distribution", 800, 600
-    );
-    mg->GetXaxis()->SetRangeUser(0., 0.4);
-    mg->GetYaxis()->SetRangeUser(0., 0.012);
-    mg->Draw("ALP");
-    std::string title = "Fermi Momentum Distribution;Momentum (GeV/c);"
-                        "Probability Density (c/GeV)";
-    mg->SetTitle(title.c_str());
-    legend->Draw();
-
-    canvas->SaveAs(combined_plot_file.c_str());
-    delete canvas; // Clean up
+    GenerateCombinedPlot(distributions, combined_plot_file);
+}
+
+/**
+ * Opens a multi-page document; the plots added until EndPlotDocument
+ * become its pages.
+ */
+bool PlotGeneratorDeuteron::BeginPlotDocument(const std::string& document_file)
+{
+    return backend->OpenDocument(document_file);
+}
+
+void PlotGeneratorDeuteron::AddSinglePlotPage(const DistributionView& distribution)
+{
+    backend->AddPage(SinglePlotSpec(distribution));
+}
+
+void PlotGeneratorDeuteron::AddCombinedPlotPage(
+    const std::vector<DistributionView>& distributions)
+{
+    backend->AddPage(CombinedPlotSpec(distributions));
+}
+
+bool PlotGeneratorDeuteron::EndPlotDocument()
+{
+    return backend->CloseDocument();
 }
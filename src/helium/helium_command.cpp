@@ -0,0 +1,140 @@
+/**
+ * @file helium_command.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Implementation of the helium command.
+ *
+ * @details
+ * Every selected 3He table is converted by its own loader, so the tables are
+ * processed in parallel. The converted columns stay in memory for the combined
+ * plot, and in watch mode only the changed tables are converted again.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/helium/helium_command.h"
+#include "../include/helium/momentum_data_loader.h"
+#include "../include/helium/plot_generator_helium.h"
+#include "../include/common/distribution_file.h"
+#include "../include/common/file_watcher.h"
+#include "../include/common/parallel_for.h"
+#include "../include/common/shared_table.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Converts and normalises the given 3He tables from the input folder into
+ * their slots of the data sets.
+ */
+static void ConvertTables(
+    const RunOptions& options, const std::vector<HeliumTable>& tables,
+    const std::vector<size_t>& indices, std::vector<std::string>& output_file_paths,
+    std::vector<std::pair<std::vector<float>, std::vector<float>>>& all_data_sets)
+{
+    // Each table is converted by its own loader, so the tables can be processed in parallel.
+    // The processed columns are kept in memory for the plot.
+    ParallelFor(indices.size(), options.threads, [&](size_t k) {
+        size_t i = indices[k];
+        MomentumDataLoader loader;
+        std::string input_file_path = options.input_dir + "/" + tables[i].name + ".txt";
+        std::vector<float>& momenta = all_data_sets[i].first;
+        std::vector<float>& probabilities = all_data_sets[i].second;
+        momenta.clear();
+        probabilities.clear();
+        output_file_paths[i] = options.data_dir + "/" + tables[i].name + "_converted"
+                             + (options.binary ? ".bin" : ".txt");
+
+        if (options.binary) {
+            for (const auto& [momentum, probability] : loader.LoadProcessedData(
+                     input_file_path, tables[i].is_momentum_in_fm, tables[i].is_prob_normalized)) {
+                momenta.push_back(momentum);
+                probabilities.push_back(probability);
+            }
+            DistributionFile::WriteBinary(output_file_paths[i], momenta.data(),
+                                          probabilities.data(), momenta.size());
+        } else {
+            loader.LoadAndProcessData(input_file_path, output_file_paths[i],
+                                      tables[i].is_momentum_in_fm, tables[i].is_prob_normalized,
+                                      momenta, probabilities);
+        }
+        if (options.publish && !momenta.empty()) {
+            SharedTable::Publish(tables[i].name, momenta.data(), probabilities.data(),
+                                 momenta.size());
+        }
+    });
+    for (size_t i : indices) {
+        std::cout << "Processed and saved: " << output_file_paths[i] << std::endl;
+    }
+}
+
+int RunHelium(const RunOptions& options)
+{
+    std::vector<HeliumTable> tables;
+    std::vector<std::string> table_names;
+    for (const HeliumTable& table : HELIUM_TABLES) {
+        table_names.push_back(table.name);
+        if (IsSelected(options, table.name)) {
+            tables.push_back(table);
+        }
+    }
+    if (!CheckSelection(options.models, table_names)) {
+        return 1;
+    }
+
+    std::vector<size_t> indices(tables.size());
+    for (size_t i = 0; i < tables.size(); ++i) {
+        indices[i] = i;
+    }
+    std::vector<std::string> output_file_paths(tables.size());
+    std::vector<std::pair<std::vector<float>, std::vector<float>>> all_data_sets(tables.size());
+    ConvertTables(options, tables, indices, output_file_paths, all_data_sets);
+
+    const std::string plot_file = options.plot_dir + "/combined_momentum_distribution_helium.png";
+    std::unique_ptr<PlotGeneratorHelium> generator_he;
+    if (options.plot) {
+        generator_he = std::make_unique<PlotGeneratorHelium>(
+            CreatePlotBackend(options.plot_backend));
+        generator_he->SetMaxPlotPoints(options.max_plot_points);
+        generator_he->SetForceRender(options.force_plot);
+        generator_he->GenerateCombinedPlot(all_data_sets, plot_file);
+    }
+    if (!options.watch) {
+        return 0;
+    }
+
+    FileWatcher watcher;
+    for (const HeliumTable& table : tables) {
+        if (!watcher.Add(options.input_dir + "/" + table.name + ".txt")) {
+            return 1;
+        }
+    }
+    std::cout << "Watching the input tables in " << options.input_dir
+              << " for changes (Ctrl+C to stop)." << std::endl;
+    for (std::vector<std::string> changed = watcher.WaitForChanges(); !changed.empty();
+         changed = watcher.WaitForChanges()) {
+        auto start = std::chrono::steady_clock::now();
+        indices.clear();
+        for (size_t i = 0; i < tables.size(); ++i) {
+            std::string input_file_path = options.input_dir + "/" + tables[i].name + ".txt";
+            if (std::find(changed.begin(), changed.end(), input_file_path) != changed.end()) {
+                indices.push_back(i);
+            }
+        }
+        ConvertTables(options, tables, indices, output_file_paths, all_data_sets);
+        if (generator_he) {
+            generator_he->GenerateCombinedPlot(all_data_sets, plot_file);
+        }
+        double elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "Updated " << indices.size() << " of " << tables.size() << " tables in "
+                  << elapsed_ms << " ms." << std::endl;
+    }
+    return 1;
+}
@@ -18,6 +18,10 @@
  * - Converting momentum from fm^-1 to GeV/c, ensuring dataset consistency.
  * - Normalizing probability densities for uniform comparison and analysis.
  * - Storing processed data in output files for further analysis.
+ * - Streaming large tables in fixed-size blocks, so that conversion, 
+ *   integration and normalization run with constant memory.
+ * - Validating every table while it is parsed (malformed rows, ordering, 
+ *   negative densities) and collecting its summary statistics.
  * - Creating a combined plot for all datasets, illustrating the momentum 
  *   distributions of both the N* resonance and the proton within the ^3He nucleus.
  * 
@@ -30,13 +34,18 @@
 
 #include "../include/helium/momentum_data_loader.h"
 #include <fstream>
-#include <sstream>
 #include <iostream>
 #include <iomanip> // for std::setprecision
+#include <cstdlib> // for std::strtof
+#include <cstring> // for std::memchr
+#include <cctype>  // for std::isspace
+#include <algorithm>
+#include <sys/stat.h>
 
 const double PI = 3.14159265358979323846;
 const double FM_TO_GEV = 0.1973; // Conversion factor from fm^-1 to GeV/c
 const double NORMAL = 0.7163;  // Probability to find a bound deuteron inside the three-body (N∗)-n-p bound state
+const std::size_t READ_BLOCK_SIZE = 1 << 20; // Bytes read from disk per block
 
 /**
  * Loads and processes data from a specified input file, converting momentum units and 
@@ -47,6 +56,40 @@ void MomentumDataLoader::LoadAndProcessData(
     const std::string& output_file_path,
     bool is_momentum_in_fm,
     bool is_prob_normalized) 
+{
+    ProcessToFile(input_file_path, output_file_path, is_momentum_in_fm,
+                  is_prob_normalized, nullptr, nullptr);
+}
+
+/**
+ * Processes the input file like LoadAndProcessData and keeps the processed 
+ * momenta and probability densities in the supplied vectors.
+ */
+void MomentumDataLoader::LoadAndProcessData(
+    const std::string& input_file_path,
+    const std::string& output_file_path,
+    bool is_momentum_in_fm,
+    bool is_prob_normalized,
+    std::vector<float>& momenta,
+    std::vector<float>& probabilities) 
+{
+    momenta.clear();
+    probabilities.clear();
+    ProcessToFile(input_file_path, output_file_path, is_momentum_in_fm,
+                  is_prob_normalized, &momenta, &probabilities);
+}
+
+/**
+ * Streams the converted rows of the input file into the output file and, if 
+ * requested, into the in-memory columns.
+ */
+void MomentumDataLoader::ProcessToFile(
+    const std::string& input_file_path,
+    const std::string& output_file_path,
+    bool is_momentum_in_fm,
+    bool is_prob_normalized,
+    std::vector<float>* momenta,
+    std::vector<float>* probabilities) 
 {
     std::ifstream input_file(input_file_path);
     std::ofstream output_file(output_file_path, std::ios::out);
@@ -61,75 +104,290 @@ void MomentumDataLoader::LoadAndProcessData(
                   << std::endl;
         return;
     }
+    input_file.close();
 
-    std::string line;
-    while (std::getline(input_file, line)) {
-        auto [momentum, probability] = ParseAndProcessLine(
-            line, is_momentum_in_fm, is_prob_normalized);
-        output_file << std::fixed << std::setprecision(7) << momentum << "\t" 
-                    << std::setprecision(10) << probability << std::endl;
-    }
+    StreamProcessedData(input_file_path, is_momentum_in_fm, is_prob_normalized,
+        [&](const MomentumDataChunk& chunk) {
+            for (size_t i = 0; i < chunk.Size(); ++i) {
+                output_file << std::fixed << std::setprecision(7) 
+                            << chunk.momenta[i] << "\t" << std::setprecision(10) 
+                            << chunk.probabilities[i] << '\n';
+            }
+            if (momenta != nullptr && probabilities != nullptr) {
+                momenta->insert(momenta->end(),
+                                chunk.momenta.begin(), chunk.momenta.end());
+                probabilities->insert(probabilities->end(),
+                                      chunk.probabilities.begin(),
+                                      chunk.probabilities.end());
+            }
+            return true;
+        });
+    ReportStatistics(input_file_path);
 }
 
 /**
- * Parses and processes a single line of input data, converting momentum units 
- * from fm^-1 to GeV/c and normalizing probability densities if specified.
+ * Loads data from a specified file path, parsing each line as a pair 
+ * of momentum and probability density values.
  */
-std::pair<float, float> MomentumDataLoader::ParseAndProcessLine(
-    const std::string& line, bool is_momentum_in_fm, bool is_prob_normalized) 
+std::vector<std::pair<float, float>> MomentumDataLoader::LoadData(
+    const std::string& file_path) 
 {
-    std::istringstream iss(line);
-    float momentum, probability;
-    if (!(iss >> momentum >> probability)) {
-        return {0.0f, 0.0f}; // Return zeros if parsing fails
+    std::vector<std::pair<float, float>> data;
+    std::ifstream file(file_path);
+
+    if (!file.is_open()) {
+        std::cerr << "Could not open file: " << file_path << std::endl;
+        return data; // Return empty data if file can't be opened
+    }
+    file.close();
+
+    // Reserve for the typical row length to avoid repeated reallocation. Only a
+    // regular file has a meaningful size: seeking to the end of a directory
+    // reports LLONG_MAX, and of a pipe -1.
+    struct stat status;
+    if (stat(file_path.c_str(), &status) == 0 && S_ISREG(status.st_mode)) {
+        data.reserve(static_cast<size_t>(status.st_size) / 16 + 1);
     }
 
+    StreamData(file_path, [&data](const MomentumDataChunk& chunk) {
+        for (size_t i = 0; i < chunk.Size(); ++i) {
+            data.push_back({chunk.momenta[i], chunk.probabilities[i]});
+        }
+        return true;
+    });
+    ReportStatistics(file_path);
+
+    return data;
+}
+
+/**
+ * Loads raw data into memory with the unit conversion and normalization 
+ * applied while the rows are parsed.
+ */
+std::vector<std::pair<float, float>> MomentumDataLoader::LoadProcessedData(
+    const std::string& file_path, bool is_momentum_in_fm, bool is_prob_normalized)
+{
+    std::vector<std::pair<float, float>> data;
+    StreamProcessedData(file_path, is_momentum_in_fm, is_prob_normalized,
+        [&data](const MomentumDataChunk& chunk) {
+            for (size_t i = 0; i < chunk.Size(); ++i) {
+                data.push_back({chunk.momenta[i], chunk.probabilities[i]});
+            }
+            return true;
+        });
+    ReportStatistics(file_path);
+
+    return data;
+}
+
+/**
+ * Streams the raw table in blocks of rows.
+ */
+std::size_t MomentumDataLoader::StreamData(
+    const std::string& file_path, const ChunkCallback& callback,
+    std::size_t chunk_size)
+{
+    return StreamRows(file_path, 1.0, 1.0, callback, chunk_size);
+}
+
+/**
+ * Streams the table in blocks of rows, converting momentum units from fm^-1 
+ * to GeV/c and normalizing probability densities if specified.
+ */
+std::size_t MomentumDataLoader::StreamProcessedData(
+    const std::string& file_path, bool is_momentum_in_fm, 
+    bool is_prob_normalized, const ChunkCallback& callback,
+    std::size_t chunk_size)
+{
     double momentum_convers_factor = is_momentum_in_fm ? FM_TO_GEV : 1.0;
     double prob_normaliz_factor = is_prob_normalized 
                                             ? (4.0 * PI) / FM_TO_GEV 
                                             : (4.0 * PI) / NORMAL;
-    
-    momentum *= momentum_convers_factor;    // Convert momentum if necessary
-    probability *= prob_normaliz_factor;    // Normalize probability
 
-    return {momentum, probability};
-    
+    return StreamRows(file_path, momentum_convers_factor, prob_normaliz_factor,
+                      callback, chunk_size);
 }
 
 /**
- * Loads data from a specified file path, parsing each line as a pair 
- * of momentum and probability density values.
+ * Integrates the probability density over momentum with the trapezoidal rule. 
+ * The integral is part of the statistics collected while the table is streamed.
  */
-std::vector<std::pair<float, float>> MomentumDataLoader::LoadData(
-    const std::string& file_path) 
+double MomentumDataLoader::IntegrateData(
+    const std::string& file_path, std::size_t chunk_size)
 {
-    std::vector<std::pair<float, float>> data;
-    std::ifstream file(file_path);
-    std::string line;
+    if (StreamData(file_path, [](const MomentumDataChunk&) { return true; }, chunk_size) == 0) {
+        std::cerr << "Error: No data rows could be read from: " << file_path << std::endl;
+        return 0.;
+    }
+    return last_statistics.trapezoid_integral;
+}
 
+/**
+ * Rescales the table to unit integral. The first pass computes the integral, 
+ * the second pass streams the rescaled rows to the output file.
+ */
+bool MomentumDataLoader::NormalizeData(
+    const std::string& input_file_path, const std::string& output_file_path,
+    std::size_t chunk_size)
+{
+    double integral = IntegrateData(input_file_path, chunk_size);
+    if (last_statistics.rows == 0) {
+        return false; // Reported by IntegrateData
+    }
+    if (!(integral > 0.)) {
+        std::cerr << "Error: Cannot normalize data with non-positive integral: " 
+                  << input_file_path << std::endl;
+        return false;
+    }
+
+    std::ofstream output_file(output_file_path, std::ios::out);
+    if (!output_file.is_open()) {
+        std::cerr << "Error: Could not open output file: " << output_file_path 
+                  << std::endl;
+        return false;
+    }
+
+    const double scale = 1.0 / integral;
+    StreamData(input_file_path, [&](const MomentumDataChunk& chunk) {
+        for (size_t i = 0; i < chunk.Size(); ++i) {
+            output_file << std::fixed << std::setprecision(7) 
+                        << chunk.momenta[i] << "\t" << std::setprecision(10) 
+                        << chunk.probabilities[i] * scale << '\n';
+        }
+        return true;
+    }, chunk_size);
+    return true;
+}
+
+/**
+ * Reads the file in fixed-size byte blocks and splits them into lines; an 
+ * incomplete line at the end of a block is carried over to the next one. 
+ * Parsed and scaled rows are collected into a reusable block of at most 
+ * chunk_size rows that is handed to the callback whenever it is full.
+ */
+std::size_t MomentumDataLoader::StreamRows(
+    const std::string& file_path, double momentum_factor,
+    double probability_factor, const ChunkCallback& callback,
+    std::size_t chunk_size)
+{
+    // A table that cannot be read must not report the statistics of the previous one
+    last_statistics = DistributionStatistics();
+    std::ifstream file(file_path, std::ios::binary);
     if (!file.is_open()) {
         std::cerr << "Could not open file: " << file_path << std::endl;
-        return data; // Return empty data if file can't be opened
+        return 0;
     }
+    if (chunk_size == 0) {
+        chunk_size = DEFAULT_CHUNK_SIZE;
+    }
+
+    MomentumDataChunk chunk;
+    chunk.momenta.reserve(chunk_size);
+    chunk.probabilities.reserve(chunk_size);
+
+    std::string pending;    // Unprocessed bytes, always ending with a partial line
+    std::vector<char> block(READ_BLOCK_SIZE);
+    size_t rows = 0;
+    bool keep_going = true;
+    StatisticsAccumulator statistics;
 
-    while (std::getline(file, line)) {
-        auto [momentum, probability] = ParseLine(line);
-        data.push_back({momentum, probability});
+    auto flush = [&]() {
+        if (chunk.Size() == 0) {
+            return;
+        }
+        rows += chunk.Size();
+        statistics.Add(chunk.momenta.data(), chunk.probabilities.data(), chunk.Size());
+        keep_going = callback(chunk);
+        chunk.momenta.clear();
+        chunk.probabilities.clear();
+    };
+
+    auto add_line = [&](const char* begin, const char* end) {
+        float momentum, probability;
+        if (!ParseLine(begin, end, momentum, probability)) {
+            // Blank lines (e.g. a trailing empty line) are not data rows
+            if (std::find_if(begin, end, [](char c) { return !std::isspace(
+                    static_cast<unsigned char>(c)); }) != end) {
+                statistics.AddBadRow();
+            }
+            return;
+        }
+        chunk.momenta.push_back(static_cast<float>(momentum * momentum_factor));
+        chunk.probabilities.push_back(
+            static_cast<float>(probability * probability_factor));
+        if (chunk.Size() == chunk_size) {
+            flush();
+        }
+    };
+
+    while (keep_going && file) {
+        file.read(block.data(), block.size());
+        pending.append(block.data(), static_cast<size_t>(file.gcount()));
+
+        const char* begin = pending.data();
+        const char* end = begin + pending.size();
+        while (keep_going) {
+            const char* newline = static_cast<const char*>(
+                std::memchr(begin, '\n', end - begin));
+            if (newline == nullptr) {
+                break;
+            }
+            add_line(begin, newline);
+            begin = newline + 1;
+        }
+        pending.erase(0, begin - pending.data());
     }
 
-    file.close();
-    return data;
+    // The last line may lack a terminating newline
+    if (keep_going && !pending.empty()) {
+        add_line(pending.data(), pending.data() + pending.size());
+    }
+    if (keep_going) {
+        flush();
+    }
+
+    last_statistics = statistics.Result();
+    return rows;
 }
 
 /**
  * Parses a single line of text to extract momentum and probability density values.
  */
-std::pair<float, float> MomentumDataLoader::ParseLine(const std::string& line) 
+bool MomentumDataLoader::ParseLine(
+    const char* begin, const char* end, float& momentum, float& probability) 
+{
+    // The line is followed by a newline or the terminating null of the buffer,
+    // so strtof cannot read past the buffer; end pointers beyond the line 
+    // mean that a value was missing.
+    char* next = nullptr;
+    momentum = std::strtof(begin, &next);
+    if (next == begin || next > end) {
+        return false;
+    }
+    const char* rest = next;
+    probability = std::strtof(rest, &next);
+    return next != rest && next <= end;
+}
+
+/**
+ * Reports malformed rows, unordered momenta and negative densities found 
+ * while reading a table.
+ */
+void MomentumDataLoader::ReportStatistics(const std::string& file_path) const
 {
-    std::istringstream iss(line);
-    float momentum, probability;
-    if (!(iss >> momentum >> probability)) {
-        return {0.0f, 0.0f}; // Return zeros if parsing fails
+    const DistributionStatistics& stats = last_statistics;
+    if (stats.bad_rows > 0) {
+        std::cerr << "Warning: Skipped " << stats.bad_rows 
+                  << " malformed row(s) in " << file_path << std::endl;
+    }
+    if (stats.non_monotonic > 0) {
+        std::cerr << "Warning: " << stats.non_monotonic 
+                  << " row(s) with non-increasing momentum in " << file_path 
+                  << std::endl;
+    }
+    if (stats.negative > 0) {
+        std::cerr << "Warning: " << stats.negative 
+                  << " row(s) with negative probability density in " << file_path 
+                  << std::endl;
     }
-    return {momentum, probability};
 }
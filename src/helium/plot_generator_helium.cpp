@@ -19,10 +19,11 @@
 
 #include "../include/helium/plot_generator_helium.h"
 #include <iostream>
-#include <TCanvas.h>
-#include <TGraph.h>
-#include <TAxis.h>
-#include <TLegend.h>
+#include <utility>
+
+PlotGeneratorHelium::PlotGeneratorHelium(std::unique_ptr<PlotBackend> backend)
+    : backend(std::make_unique<CachedPlotBackend>(
+          backend ? std::move(backend) : CreatePlotBackend(DefaultPlotBackendName()))) {}
 
 /**
  * Generates a plot that combines multiple datasets to depict both the N* resonance 
@@ -33,25 +34,24 @@ void PlotGeneratorHelium::GenerateCombinedPlot(
     std::vector<float>>>& data_sets, 
     const std::string& output_file_path) 
 {
-    auto* canvas = new TCanvas("canvas", "Momentum Distribution", 800, 600);
-    TLegend legend(0.7, 0.7, 0.9, 0.9);
+    PlotSpec spec;
+    spec.canvas_title = "Momentum Distribution";
+    spec.x_max = 0.4;
+    spec.show_legend = true;
 
     for (size_t i = 0; i < data_sets.size(); ++i) {
-        TGraph* graph = new TGraph(data_sets[i].first.size(), 
-                                   data_sets[i].first.data(), 
-                                   data_sets[i].second.data()
-        );
+        std::vector<float> momenta, probabilities;
+        downsampler.Downsample(data_sets[i].first.data(), data_sets[i].second.data(),
+                               data_sets[i].first.size(), momenta, probabilities);
 
-        // Customize each graph's appearance
-        graph->SetLineColor(i + 1); // Change line color for each graph
-        graph->GetXaxis()->SetRangeUser(0., 0.4);
-        graph->Draw(i == 0 ? "AL" : "L"); // Draw the first graph with axis, subsequent graphs on top
-        
-        legend.AddEntry(graph, ("DataSet " + std::to_string(i)).c_str(), "l");
+        // Customize each curve's appearance
+        PlotCurve curve;
+        curve.label = "DataSet " + std::to_string(i);
+        curve.color = i + 1; // Change line color for each graph
+        curve.x.assign(momenta.begin(), momenta.end());
+        curve.y.assign(probabilities.begin(), probabilities.end());
+        spec.curves.push_back(std::move(curve));
     }
 
-    legend.Draw();
-    canvas->SaveAs(output_file_path.c_str());
-
-    delete canvas; // Clean up
+    backend->Render(spec, output_file_path);
 }
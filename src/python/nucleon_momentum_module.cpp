@@ -0,0 +1,751 @@
+/**
+ * @file nucleon_momentum_module.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Python extension module "nucleon_momentum" exposing the deuteron
+ *        calculator, the 3He loader, the interpolator and the sampler.
+ *
+ * @details
+ * The module uses only the CPython API and the buffer protocol, so it builds
+ * without NumPy or a binding library and still works on NumPy arrays without
+ * copying them:
+ *  - Inputs that are contiguous float64 buffers (NumPy arrays, array('d'),
+ *    memoryviews) are read in place. Other sequences, such as lists or float32
+ *    arrays, are converted once.
+ *  - Results are returned as nucleon_momentum.Array objects, which own their
+ *    data and export it through the buffer protocol; numpy.asarray() wraps
+ *    them without a copy. Alternatively a writable float64 buffer of the
+ *    right length can be passed as "out" to receive the results directly.
+ *  - Scalar inputs give scalar results.
+ * The GIL is released while the C++ kernels run, so Python threads can
+ * evaluate in parallel. The kernels then use the Interpolator's or Sampler's
+ * table without holding a reference, so an initialised object cannot be
+ * initialised again.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "../include/common/momentum_interpolator.h"
+#include "../include/common/momentum_sampler.h"
+#include "../include/deuteron/momentum_distribution.h"
+#include "../include/helium/momentum_data_loader.h"
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct ArrayObject {
+    PyObject_HEAD
+    std::vector<double>* values;
+    Py_ssize_t shape;
+    Py_ssize_t stride;
+};
+
+static void ArrayDealloc(ArrayObject* self)
+{
+    delete self->values;
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+static int ArrayGetBuffer(ArrayObject* self, Py_buffer* view, int flags)
+{
+    view->obj = reinterpret_cast<PyObject*>(self);
+    Py_INCREF(self);
+    view->buf = self->values->data();
+    view->len = self->shape * Py_ssize_t(sizeof(double));
+    view->readonly = 0;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>("d") : nullptr;
+    view->ndim = 1;
+    view->shape = &self->shape;
+    view->strides = &self->stride;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+static Py_ssize_t ArrayLength(ArrayObject* self)
+{
+    return self->shape;
+}
+
+static PyObject* ArrayItem(ArrayObject* self, Py_ssize_t index)
+{
+    if (index < 0 || index >= self->shape) {
+        PyErr_SetString(PyExc_IndexError, "Array index out of range");
+        return nullptr;
+    }
+    return PyFloat_FromDouble((*self->values)[std::size_t(index)]);
+}
+
+/**
+ * Returns a type object with the given name and all slots empty. The slots are
+ * assigned in PyInit_nucleon_momentum, since positional initialisers of the
+ * Python structures depend on the Python version.
+ */
+static PyTypeObject NewType(const char* name)
+{
+    PyTypeObject type{};
+    PyVarObject head = {PyObject_HEAD_INIT(nullptr) 0};
+    type.ob_base = head;
+    type.tp_name = name;
+    return type;
+}
+
+static PyBufferProcs ARRAY_BUFFER{};
+static PySequenceMethods ARRAY_SEQUENCE{};
+static PyTypeObject ArrayType = NewType("nucleon_momentum.Array");
+
+/**
+ * Wraps a vector into a new Array; the vector is moved, not copied.
+ */
+static PyObject* NewArray(std::vector<double>&& values)
+{
+    ArrayObject* array = PyObject_New(ArrayObject, &ArrayType);
+    if (array == nullptr) {
+        return nullptr;
+    }
+    array->values = new std::vector<double>(std::move(values));
+    array->shape = Py_ssize_t(array->values->size());
+    array->stride = sizeof(double);
+    return reinterpret_cast<PyObject*>(array);
+}
+
+static bool IsDoubleFormat(const char* format)
+{
+    if (format == nullptr) {
+        return true; // Unformatted buffers are bytes; the item size decides
+    }
+    if (*format == '@' || *format == '=' || *format == '<') {
+        ++format;
+    }
+    return std::strcmp(format, "d") == 0;
+}
+
+/**
+ * Column of doubles read from a Python object: borrowed from a contiguous
+ * float64 buffer, converted from any other sequence, or a single number.
+ */
+class InputColumn {
+public:
+    ~InputColumn()
+    {
+        if (has_view) {
+            PyBuffer_Release(&view);
+        }
+    }
+
+    bool Parse(PyObject* object, const char* name)
+    {
+        if (PyFloat_Check(object) || PyLong_Check(object)) {
+            scalar_value = PyFloat_AsDouble(object);
+            is_scalar = true;
+            data = &scalar_value;
+            size = 1;
+            return !PyErr_Occurred();
+        }
+        if (PyObject_CheckBuffer(object)
+            && PyObject_GetBuffer(object, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0) {
+            has_view = true;
+            if (view.itemsize == sizeof(double) && IsDoubleFormat(view.format)) {
+                data = static_cast<const double*>(view.buf);
+                size = std::size_t(view.len) / sizeof(double);
+                return true;
+            }
+            PyBuffer_Release(&view);
+            has_view = false;
+        }
+        PyErr_Clear();
+
+        std::string message = std::string(name) + " must be a number or a sequence of numbers";
+        PyObject* sequence = PySequence_Fast(object, message.c_str());
+        if (sequence == nullptr) {
+            return false;
+        }
+        Py_ssize_t length = PySequence_Fast_GET_SIZE(sequence);
+        copy.resize(std::size_t(length));
+        for (Py_ssize_t i = 0; i < length; ++i) {
+            copy[std::size_t(i)] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(sequence, i));
+        }
+        Py_DECREF(sequence);
+        data = copy.data();
+        size = copy.size();
+        return !PyErr_Occurred();
+    }
+
+    std::vector<double> Vector() const { return std::vector<double>(data, data + size); }
+
+    const double* data = nullptr;
+    std::size_t size = 0;
+    bool is_scalar = false;
+
+private:
+    Py_buffer view;
+    bool has_view = false;
+    std::vector<double> copy;
+    double scalar_value = 0.;
+};
+
+/**
+ * Destination of a batch result: a new Array, or the caller's writable
+ * float64 buffer passed as "out".
+ */
+class OutputColumn {
+public:
+    ~OutputColumn()
+    {
+        if (has_view) {
+            PyBuffer_Release(&view);
+        }
+        Py_XDECREF(result);
+    }
+
+    bool Prepare(PyObject* out, std::size_t count)
+    {
+        if (out == nullptr || out == Py_None) {
+            result = NewArray(std::vector<double>(count));
+            if (result == nullptr) {
+                return false;
+            }
+            data = reinterpret_cast<ArrayObject*>(result)->values->data();
+            return true;
+        }
+        if (PyObject_GetBuffer(out, &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+            return false;
+        }
+        has_view = true;
+        if (view.itemsize != sizeof(double) || !IsDoubleFormat(view.format)
+            || std::size_t(view.len) != count * sizeof(double)) {
+            PyErr_SetString(PyExc_ValueError, "out must be a contiguous float64 buffer of the input's length");
+            return false;
+        }
+        data = static_cast<double*>(view.buf);
+        result = out;
+        Py_INCREF(result);
+        return true;
+    }
+
+    /**
+     * Hands the result object over to the caller.
+     */
+    PyObject* Release()
+    {
+        PyObject* released = result;
+        result = nullptr;
+        return released;
+    }
+
+    double* data = nullptr;
+
+private:
+    Py_buffer view;
+    bool has_view = false;
+    PyObject* result = nullptr;
+};
+
+/**
+ * Applies a batch kernel kernel(input, output, count) to x, with the GIL
+ * released while it runs.
+ */
+template <typename Kernel>
+static PyObject* ApplyBatch(PyObject* x, PyObject* out, const char* name, Kernel kernel)
+{
+    InputColumn input;
+    if (!input.Parse(x, name)) {
+        return nullptr;
+    }
+    if (input.is_scalar && (out == nullptr || out == Py_None)) {
+        double value = 0.;
+        kernel(input.data, &value, 1);
+        return PyFloat_FromDouble(value);
+    }
+    OutputColumn output;
+    if (!output.Prepare(out, input.size)) {
+        return nullptr;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    kernel(input.data, output.data, input.size);
+    Py_END_ALLOW_THREADS
+    return output.Release();
+}
+
+/**
+ * Builds the (momenta, densities) tuple of two Arrays.
+ */
+static PyObject* ColumnPair(std::vector<double>&& first, std::vector<double>&& second)
+{
+    PyObject* first_array = NewArray(std::move(first));
+    PyObject* second_array = first_array != nullptr ? NewArray(std::move(second)) : nullptr;
+    if (second_array == nullptr) {
+        Py_XDECREF(first_array);
+        return nullptr;
+    }
+    return Py_BuildValue("(NN)", first_array, second_array);
+}
+
+struct InterpolatorObject {
+    PyObject_HEAD
+    MomentumInterpolator* interpolator;
+};
+
+static void InterpolatorDealloc(InterpolatorObject* self)
+{
+    delete self->interpolator;
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+static int InterpolatorInit(InterpolatorObject* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"momenta", "densities", "method", nullptr};
+    PyObject* momenta_object = nullptr;
+    PyObject* densities_object = nullptr;
+    const char* method_name = "pchip";
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|s", const_cast<char**>(keywords),
+                                     &momenta_object, &densities_object, &method_name)) {
+        return -1;
+    }
+
+    InterpolationMethod method;
+    std::string method_string = method_name;
+    if (method_string == "linear") {
+        method = InterpolationMethod::kLinear;
+    } else if (method_string == "cubic") {
+        method = InterpolationMethod::kCubicSpline;
+    } else if (method_string == "pchip") {
+        method = InterpolationMethod::kPchip;
+    } else {
+        PyErr_SetString(PyExc_ValueError, "method must be 'linear', 'cubic' or 'pchip'");
+        return -1;
+    }
+
+    InputColumn momenta, densities;
+    if (!momenta.Parse(momenta_object, "momenta") || !densities.Parse(densities_object, "densities")) {
+        return -1;
+    }
+    MomentumInterpolator* interpolator = new MomentumInterpolator(momenta.Vector(), densities.Vector(), method);
+    if (momenta.size != densities.size || !interpolator->IsValid()) {
+        delete interpolator;
+        PyErr_SetString(PyExc_ValueError,
+                        "momenta and densities must have the same length of at least two, "
+                        "with strictly increasing momenta");
+        return -1;
+    }
+    // Checked only now with the GIL held throughout: parsing the inputs can run
+    // Python code, which may initialise the object from another thread.
+    if (self->interpolator != nullptr) {
+        delete interpolator;
+        PyErr_SetString(PyExc_RuntimeError, "Interpolator is already initialised");
+        return -1;
+    }
+    self->interpolator = interpolator;
+    return 0;
+}
+
+static bool CheckInterpolator(InterpolatorObject* self)
+{
+    if (self->interpolator == nullptr) {
+        PyErr_SetString(PyExc_RuntimeError, "Interpolator is not initialised");
+        return false;
+    }
+    return true;
+}
+
+static PyObject* InterpolatorEvaluate(InterpolatorObject* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"momenta", "out", nullptr};
+    PyObject* x = nullptr;
+    PyObject* out = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", const_cast<char**>(keywords), &x, &out)
+        || !CheckInterpolator(self)) {
+        return nullptr;
+    }
+    const MomentumInterpolator* interpolator = self->interpolator;
+    return ApplyBatch(x, out, "momenta", [interpolator](const double* in, double* result, std::size_t count) {
+        interpolator->Evaluate(in, result, count);
+    });
+}
+
+static PyObject* InterpolatorEvaluateSorted(InterpolatorObject* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"momenta", "out", nullptr};
+    PyObject* x = nullptr;
+    PyObject* out = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", const_cast<char**>(keywords), &x, &out)
+        || !CheckInterpolator(self)) {
+        return nullptr;
+    }
+    const MomentumInterpolator* interpolator = self->interpolator;
+    return ApplyBatch(x, out, "momenta", [interpolator](const double* in, double* result, std::size_t count) {
+        interpolator->EvaluateSorted(in, result, count);
+    });
+}
+
+static PyObject* InterpolatorGetSize(InterpolatorObject* self, void*)
+{
+    return CheckInterpolator(self) ? PyLong_FromSize_t(self->interpolator->Size()) : nullptr;
+}
+
+static PyObject* InterpolatorGetMinMomentum(InterpolatorObject* self, void*)
+{
+    return CheckInterpolator(self) ? PyFloat_FromDouble(self->interpolator->MinMomentum()) : nullptr;
+}
+
+static PyObject* InterpolatorGetMaxMomentum(InterpolatorObject* self, void*)
+{
+    return CheckInterpolator(self) ? PyFloat_FromDouble(self->interpolator->MaxMomentum()) : nullptr;
+}
+
+static PyObject* InterpolatorGetUniformGrid(InterpolatorObject* self, void*)
+{
+    return CheckInterpolator(self) ? PyBool_FromLong(self->interpolator->IsUniformGrid()) : nullptr;
+}
+
+static PyMethodDef INTERPOLATOR_METHODS[] = {
+    {"evaluate", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(InterpolatorEvaluate)),
+     METH_VARARGS | METH_KEYWORDS, "evaluate(momenta, out=None)\n\nDensity at the given momenta (zero outside the table)."},
+    {"evaluate_sorted", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(InterpolatorEvaluateSorted)),
+     METH_VARARGS | METH_KEYWORDS, "evaluate_sorted(momenta, out=None)\n\nLike evaluate, for ascending momenta in linear time."},
+    {},
+};
+
+static PyGetSetDef INTERPOLATOR_PROPERTIES[] = {
+    {"size", reinterpret_cast<getter>(InterpolatorGetSize), nullptr, "Number of tabulated points.", nullptr},
+    {"min_momentum", reinterpret_cast<getter>(InterpolatorGetMinMomentum), nullptr, "Lower end of the table.", nullptr},
+    {"max_momentum", reinterpret_cast<getter>(InterpolatorGetMaxMomentum), nullptr, "Upper end of the table.", nullptr},
+    {"uniform_grid", reinterpret_cast<getter>(InterpolatorGetUniformGrid), nullptr, "True for an equidistant grid.", nullptr},
+    {},
+};
+
+static PyTypeObject InterpolatorType = NewType("nucleon_momentum.Interpolator");
+
+struct SamplerObject {
+    PyObject_HEAD
+    MomentumSampler* sampler;
+};
+
+static void SamplerDealloc(SamplerObject* self)
+{
+    delete self->sampler;
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+static int SamplerInit(SamplerObject* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"momenta", "densities", nullptr};
+    PyObject* momenta_object = nullptr;
+    PyObject* densities_object = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO", const_cast<char**>(keywords),
+                                     &momenta_object, &densities_object)) {
+        return -1;
+    }
+    InputColumn momenta, densities;
+    if (!momenta.Parse(momenta_object, "momenta") || !densities.Parse(densities_object, "densities")) {
+        return -1;
+    }
+    MomentumSampler* sampler = new MomentumSampler();
+    if (momenta.size != densities.size || !sampler->Build(momenta.data, densities.data, momenta.size)) {
+        delete sampler;
+        PyErr_SetString(PyExc_ValueError,
+                        "momenta and densities must have the same length of at least two, "
+                        "with strictly increasing momenta and a positive integral");
+        return -1;
+    }
+    if (self->sampler != nullptr) {
+        delete sampler;
+        PyErr_SetString(PyExc_RuntimeError, "Sampler is already initialised");
+        return -1;
+    }
+    self->sampler = sampler;
+    return 0;
+}
+
+static bool CheckSampler(SamplerObject* self)
+{
+    if (self->sampler == nullptr) {
+        PyErr_SetString(PyExc_RuntimeError, "Sampler is not initialised");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Shared argument handling of the density, cdf and quantile methods.
+ */
+template <typename Function>
+static PyObject* SamplerMap(SamplerObject* self, PyObject* args, PyObject* kwargs, const char* name, Function function)
+{
+    static const char* keywords[] = {"x", "out", nullptr};
+    PyObject* x = nullptr;
+    PyObject* out = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", const_cast<char**>(keywords), &x, &out)
+        || !CheckSampler(self)) {
+        return nullptr;
+    }
+    const MomentumSampler* sampler = self->sampler;
+    return ApplyBatch(x, out, name, [sampler, function](const double* in, double* result, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            result[i] = (sampler->*function)(in[i]);
+        }
+    });
+}
+
+static PyObject* SamplerDensity(SamplerObject* self, PyObject* args, PyObject* kwargs)
+{
+    return SamplerMap(self, args, kwargs, "momenta", &MomentumSampler::Density);
+}
+
+static PyObject* SamplerCdf(SamplerObject* self, PyObject* args, PyObject* kwargs)
+{
+    return SamplerMap(self, args, kwargs, "momenta", &MomentumSampler::Cdf);
+}
+
+static PyObject* SamplerQuantile(SamplerObject* self, PyObject* args, PyObject* kwargs)
+{
+    return SamplerMap(self, args, kwargs, "probabilities", &MomentumSampler::Quantile);
+}
+
+static PyObject* SamplerSample(SamplerObject* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"count", "seed", "out", nullptr};
+    Py_ssize_t count = 0;
+    unsigned long long seed = 0;
+    PyObject* out = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|KO", const_cast<char**>(keywords), &count, &seed, &out)
+        || !CheckSampler(self)) {
+        return nullptr;
+    }
+    if (count < 0) {
+        PyErr_SetString(PyExc_ValueError, "count must not be negative");
+        return nullptr;
+    }
+    OutputColumn output;
+    if (!output.Prepare(out, std::size_t(count))) {
+        return nullptr;
+    }
+    const MomentumSampler* sampler = self->sampler;
+    Py_BEGIN_ALLOW_THREADS
+    std::mt19937_64 engine(seed);
+    sampler->Sample(engine, output.data, std::size_t(count));
+    Py_END_ALLOW_THREADS
+    return output.Release();
+}
+
+static PyObject* SamplerGetNorm(SamplerObject* self, void*)
+{
+    return CheckSampler(self) ? PyFloat_FromDouble(self->sampler->Norm()) : nullptr;
+}
+
+static PyObject* SamplerGetMinMomentum(SamplerObject* self, void*)
+{
+    return CheckSampler(self) ? PyFloat_FromDouble(self->sampler->MinMomentum()) : nullptr;
+}
+
+static PyObject* SamplerGetMaxMomentum(SamplerObject* self, void*)
+{
+    return CheckSampler(self) ? PyFloat_FromDouble(self->sampler->MaxMomentum()) : nullptr;
+}
+
+static PyMethodDef SAMPLER_METHODS[] = {
+    {"density", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(SamplerDensity)),
+     METH_VARARGS | METH_KEYWORDS, "density(x, out=None)\n\nNormalised density at the given momenta."},
+    {"cdf", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(SamplerCdf)),
+     METH_VARARGS | METH_KEYWORDS, "cdf(x, out=None)\n\nCumulative distribution function."},
+    {"quantile", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(SamplerQuantile)),
+     METH_VARARGS | METH_KEYWORDS, "quantile(x, out=None)\n\nInverse of the cumulative distribution function."},
+    {"sample", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(SamplerSample)),
+     METH_VARARGS | METH_KEYWORDS, "sample(count, seed=0, out=None)\n\nReproducible batch of sampled momenta."},
+    {},
+};
+
+static PyGetSetDef SAMPLER_PROPERTIES[] = {
+    {"norm", reinterpret_cast<getter>(SamplerGetNorm), nullptr, "Integral of the table before normalisation.", nullptr},
+    {"min_momentum", reinterpret_cast<getter>(SamplerGetMinMomentum), nullptr, "Lower end of the table.", nullptr},
+    {"max_momentum", reinterpret_cast<getter>(SamplerGetMaxMomentum), nullptr, "Upper end of the table.", nullptr},
+    {},
+};
+
+static PyTypeObject SamplerType = NewType("nucleon_momentum.Sampler");
+
+/**
+ * Parses the deuteron model arguments shared by the calculator functions.
+ */
+static bool ParseModel(
+    PyObject* c_object, PyObject* d_object, std::vector<double>& c, std::vector<double>& d)
+{
+    InputColumn c_column, d_column;
+    if (!c_column.Parse(c_object, "c") || !d_column.Parse(d_object, "d")) {
+        return false;
+    }
+    if (c_column.size != d_column.size || c_column.size < 3 || c_column.is_scalar) {
+        PyErr_SetString(PyExc_ValueError, "c and d must be sequences of equal length (at least three)");
+        return false;
+    }
+    c = c_column.Vector();
+    d = d_column.Vector();
+    return true;
+}
+
+static PyObject* CalculateDistribution(PyObject*, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"alpha", "m_0", "c", "d", "steps", "max_momentum", nullptr};
+    double alpha = 0., m_0 = 0., max_momentum = 0.4;
+    int steps = 400;
+    PyObject* c_object = nullptr;
+    PyObject* d_object = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ddOO|id", const_cast<char**>(keywords),
+                                     &alpha, &m_0, &c_object, &d_object, &steps, &max_momentum)) {
+        return nullptr;
+    }
+    std::vector<double> c, d;
+    if (!ParseModel(c_object, d_object, c, d)) {
+        return nullptr;
+    }
+    MomentumDistributionCalculator calculator;
+    if (!calculator.SetGrid(steps, max_momentum)) {
+        PyErr_SetString(PyExc_ValueError, "steps and max_momentum must be positive");
+        return nullptr;
+    }
+
+    std::vector<double> momenta, densities;
+    Py_BEGIN_ALLOW_THREADS
+    calculator.CalculateDistribution(alpha, m_0, c, d, momenta, densities);
+    Py_END_ALLOW_THREADS
+    return ColumnPair(std::move(momenta), std::move(densities));
+}
+
+static PyObject* CalculateWaveFunctions(PyObject*, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"alpha", "m_0", "c", "d", "radii", nullptr};
+    double alpha = 0., m_0 = 0.;
+    PyObject* c_object = nullptr;
+    PyObject* d_object = nullptr;
+    PyObject* radii_object = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ddOOO", const_cast<char**>(keywords),
+                                     &alpha, &m_0, &c_object, &d_object, &radii_object)) {
+        return nullptr;
+    }
+    std::vector<double> c, d;
+    InputColumn radii_column;
+    if (!ParseModel(c_object, d_object, c, d) || !radii_column.Parse(radii_object, "radii")) {
+        return nullptr;
+    }
+
+    std::vector<double> radii = radii_column.Vector();
+    std::vector<double> u, w;
+    MomentumDistributionCalculator calculator;
+    Py_BEGIN_ALLOW_THREADS
+    calculator.CalculateWaveFunctions(alpha, m_0, c, d, radii, u, w);
+    Py_END_ALLOW_THREADS
+    return ColumnPair(std::move(u), std::move(w));
+}
+
+static PyObject* LoadHeliumTable(PyObject*, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"path", "momentum_in_fm", "normalized", nullptr};
+    const char* path = nullptr;
+    int momentum_in_fm = 1, normalized = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|pp", const_cast<char**>(keywords),
+                                     &path, &momentum_in_fm, &normalized)) {
+        return nullptr;
+    }
+
+    std::string file_path = path;
+    std::vector<double> momenta, densities;
+    Py_BEGIN_ALLOW_THREADS
+    MomentumDataLoader loader;
+    loader.StreamProcessedData(file_path, momentum_in_fm != 0, normalized != 0,
+        [&momenta, &densities](const MomentumDataChunk& chunk) {
+            momenta.insert(momenta.end(), chunk.momenta.begin(), chunk.momenta.end());
+            densities.insert(densities.end(), chunk.probabilities.begin(), chunk.probabilities.end());
+            return true;
+        });
+    Py_END_ALLOW_THREADS
+    if (momenta.empty()) {
+        PyErr_Format(PyExc_OSError, "No data could be read from %s", path);
+        return nullptr;
+    }
+    return ColumnPair(std::move(momenta), std::move(densities));
+}
+
+static PyMethodDef MODULE_METHODS[] = {
+    {"calculate_distribution", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(CalculateDistribution)),
+     METH_VARARGS | METH_KEYWORDS,
+     "calculate_distribution(alpha, m_0, c, d, steps=400, max_momentum=0.4)\n\n"
+     "Nucleon momentum distribution in the deuteron; returns (momenta, densities)."},
+    {"calculate_wave_functions", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(CalculateWaveFunctions)),
+     METH_VARARGS | METH_KEYWORDS,
+     "calculate_wave_functions(alpha, m_0, c, d, radii)\n\n"
+     "Reduced S- and D-wave functions at the radii in fm; returns (u, w)."},
+    {"load_helium_table", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(LoadHeliumTable)),
+     METH_VARARGS | METH_KEYWORDS,
+     "load_helium_table(path, momentum_in_fm=True, normalized=True)\n\n"
+     "3He table converted to GeV/c and normalised; returns (momenta, densities)."},
+    {},
+};
+
+static PyModuleDef MODULE = {
+    PyModuleDef_HEAD_INIT, "nucleon_momentum",
+    "Nucleon momentum distributions in the deuteron and 3He.\n\n"
+    "Batch functions accept float64 buffers such as NumPy arrays without copying\n"
+    "and return nucleon_momentum.Array objects, which numpy.asarray() wraps\n"
+    "without copying.",
+    -1, MODULE_METHODS, nullptr, nullptr, nullptr, nullptr,
+};
+
+PyMODINIT_FUNC PyInit_nucleon_momentum()
+{
+    ARRAY_BUFFER.bf_getbuffer = reinterpret_cast<getbufferproc>(ArrayGetBuffer);
+    ARRAY_SEQUENCE.sq_length = reinterpret_cast<lenfunc>(ArrayLength);
+    ARRAY_SEQUENCE.sq_item = reinterpret_cast<ssizeargfunc>(ArrayItem);
+
+    ArrayType.tp_basicsize = sizeof(ArrayObject);
+    ArrayType.tp_dealloc = reinterpret_cast<destructor>(ArrayDealloc);
+    ArrayType.tp_as_buffer = &ARRAY_BUFFER;
+    ArrayType.tp_as_sequence = &ARRAY_SEQUENCE;
+    ArrayType.tp_flags = Py_TPFLAGS_DEFAULT;
+    ArrayType.tp_doc = "Float64 result column exported through the buffer protocol.";
+
+    InterpolatorType.tp_basicsize = sizeof(InterpolatorObject);
+    InterpolatorType.tp_dealloc = reinterpret_cast<destructor>(InterpolatorDealloc);
+    InterpolatorType.tp_flags = Py_TPFLAGS_DEFAULT;
+    InterpolatorType.tp_doc = "Interpolator(momenta, densities, method='pchip')\n\n"
+                              "Tabulated distribution evaluated with 'linear', 'cubic' or 'pchip' interpolation.";
+    InterpolatorType.tp_methods = INTERPOLATOR_METHODS;
+    InterpolatorType.tp_getset = INTERPOLATOR_PROPERTIES;
+    InterpolatorType.tp_init = reinterpret_cast<initproc>(InterpolatorInit);
+    InterpolatorType.tp_new = PyType_GenericNew;
+
+    SamplerType.tp_basicsize = sizeof(SamplerObject);
+    SamplerType.tp_dealloc = reinterpret_cast<destructor>(SamplerDealloc);
+    SamplerType.tp_flags = Py_TPFLAGS_DEFAULT;
+    SamplerType.tp_doc = "Sampler(momenta, densities)\n\n"
+                         "Density, CDF, quantiles and inverse-CDF sampling of a tabulated distribution.";
+    SamplerType.tp_methods = SAMPLER_METHODS;
+    SamplerType.tp_getset = SAMPLER_PROPERTIES;
+    SamplerType.tp_init = reinterpret_cast<initproc>(SamplerInit);
+    SamplerType.tp_new = PyType_GenericNew;
+
+    if (PyType_Ready(&ArrayType) < 0 || PyType_Ready(&InterpolatorType) < 0 || PyType_Ready(&SamplerType) < 0) {
+        return nullptr;
+    }
+    PyObject* module = PyModule_Create(&MODULE);
+    if (module == nullptr) {
+        return nullptr;
+    }
+    PyTypeObject* types[] = {&ArrayType, &InterpolatorType, &SamplerType};
+    const char* names[] = {"Array", "Interpolator", "Sampler"};
+    for (int i = 0; i < 3; ++i) {
+        Py_INCREF(types[i]);
+        if (PyModule_AddObject(module, names[i], reinterpret_cast<PyObject*>(types[i])) < 0) {
+            Py_DECREF(types[i]);
+            Py_DECREF(module);
+            return nullptr;
+        }
+    }
+    return module;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file plot_memory_test.cpp
+ * @author AK <alex.nuclearboy@gmail.com>
+ * @brief Regression test for bounded memory use of long plotting runs.
+ *
+ * @details
+ * Renders many single and combined deuteron plots with one plot generator, as
+ * a long-lived service would, and checks that the resident set size (VmRSS in
+ * /proc/self/status) stays flat. The plots are drawn with the ROOT backend on
+ * the pooled canvas if the plugin can be loaded (CTest points PLOT_ROOT_PLUGIN
+ * at it), otherwise with the lite backend. Every plot is rendered, even if its
+ * image is up to date, and the curves change from plot to plot. The images are
+ * written as SVG, which keeps the run short without changing the objects a
+ * plot creates.
+ *
+ * Usage:
+ *     plot_memory_test <output directory> [plots] [allowed growth in KiB]
+ * The RSS is measured after a warm-up of WARMUP_PLOTS plots, which lets ROOT
+ * and the allocator reach their steady state, and again after the remaining
+ * plots. The test fails if it grew by more than the allowed amount.
+ *
+ * @version 2.0
+ * @date 2026-10-18
+ *
+ * @remark Licensed under the GNU General Public License version 3.0 (GPLv3).
+ */
+
+#include "../include/common/plot_backend.h"
+#include "../include/deuteron/plot_generator_deuteron.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+const long DEFAULT_PLOTS = 10000;       // Plots rendered in total
+const long WARMUP_PLOTS = 200;          // Plots rendered before the baseline
+const long DEFAULT_GROWTH_KIB = 4096;   // Allowed RSS growth after the warm-up
+const int GRID_STEPS = 400;             // Intervals of the synthetic curves
+const int MODELS = 3;                   // Curves in a combined plot
+
+/**
+ * Returns the resident set size of this process in KiB, or -1 if unknown.
+ */
+static long ResidentSetKiB()
+{
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key) {
+        if (key == "VmRSS:") {
+            long kib = -1;
+            status >> kib;
+            return kib;
+        }
+        status.ignore(4096, '\n');
+    }
+    return -1;
+}
+
+/**
+ * Parses a positive count from a command-line argument.
+ */
+static bool ParseCount(const char* text, long& value)
+{
+    char* end = nullptr;
+    value = std::strtol(text, &end, 10);
+    return end != text && *end == '\0' && value > 0;
+}
+
+/**
+ * Fills a curve shaped like a momentum distribution, varying with the plot number.
+ */
+static void FillCurve(long plot, int model, std::vector<double>& momentum, std::vector<double>& density)
+{
+    const double width = 0.05 + 0.01 * model + 1e-6 * (plot % 1000);
+    for (int i = 0; i <= GRID_STEPS; ++i) {
+        momentum[i] = 0.4 * i / GRID_STEPS;
+        density[i] = momentum[i] * momentum[i] * std::exp(-momentum[i] / width);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    long plots = DEFAULT_PLOTS;
+    long allowed_kib = DEFAULT_GROWTH_KIB;
+    if (argc < 2 || argc > 4
+        || (argc > 2 && !ParseCount(argv[2], plots))
+        || (argc > 3 && !ParseCount(argv[3], allowed_kib))) {
+        std::cerr << "Usage: " << argv[0] << " <output directory> [plots] [allowed growth in KiB]" << std::endl;
+        return 2;
+    }
+    const std::string output_dir = argv[1];
+
+    PlotGeneratorDeuteron generator(CreatePlotBackend("root"));
+    generator.SetForceRender(true);
+
+    std::vector<std::vector<double>> momenta(MODELS, std::vector<double>(GRID_STEPS + 1));
+    std::vector<std::vector<double>> densities(MODELS, std::vector<double>(GRID_STEPS + 1));
+    long baseline_kib = -1;
+    for (long plot = 0; plot < plots; ++plot) {
+        if (plot == std::min(WARMUP_PLOTS, plots - 1)) {
+            baseline_kib = ResidentSetKiB();
+        }
+        std::vector<DistributionView> views;
+        for (int model = 0; model < MODELS; ++model) {
+            FillCurve(plot, model, momenta[model], densities[model]);
+            views.push_back({"model" + std::to_string(model), momenta[model].data(),
+                             densities[model].data(), momenta[model].size()});
+        }
+        // Every tenth plot is a combined one, the others show a single curve
+        if (plot % 10 == 9) {
+            generator.GenerateCombinedPlot(views, output_dir + "/plot_memory_combined.svg");
+        } else {
+            generator.GenerateSinglePlot(views[plot % MODELS], output_dir + "/plot_memory_single.svg");
+        }
+    }
+    long final_kib = ResidentSetKiB();
+
+    if (baseline_kib < 0 || final_kib < 0) {
+        std::cerr << "Error: VmRSS is not available in /proc/self/status." << std::endl;
+        return 1;
+    }
+    long growth_kib = final_kib - baseline_kib;
+    std::cout << "Rendered " << plots << " plots: VmRSS " << baseline_kib << " KiB after the warm-up, "
+              << final_kib << " KiB at the end (growth " << growth_kib << " KiB, allowed "
+              << allowed_kib << " KiB)." << std::endl;
+    if (growth_kib > allowed_kib) {
+        std::cerr << "Error: Memory grew by " << growth_kib << " KiB while plotting." << std::endl;
+        return 1;
+    }
+    return 0;
+}